@@ -0,0 +1,136 @@
+#include "AssetPack.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const Uint8* AssetPack::base = nullptr;
+size_t AssetPack::mappedSize = 0;
+const AssetPackEntry* AssetPack::entries = nullptr;
+Uint32 AssetPack::count = 0;
+#ifdef _WIN32
+void* AssetPack::fileHandle = nullptr;
+void* AssetPack::mappingHandle = nullptr;
+#endif
+
+bool AssetPack::Mount(const char* filePath) {
+    Unmount();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!view) {
+        std::cerr << "Error: Could not map asset pack " << filePath << std::endl;
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = open(filePath, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        view = mmap(NULL, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);  // El mapeo sigue siendo válido sin el descriptor
+    if (view == MAP_FAILED) {
+        std::cerr << "Error: Could not map asset pack " << filePath << std::endl;
+        return false;
+    }
+    mappedSize = static_cast<size_t>(info.st_size);
+#endif
+    base = static_cast<const Uint8*>(view);
+
+    // Validar la cabecera y que todas las entradas caigan dentro del archivo
+    const auto* header = reinterpret_cast<const AssetPackHeader*>(base);
+    bool valid = mappedSize >= sizeof(AssetPackHeader) &&
+                 std::memcmp(header->magic, ASSET_PACK_MAGIC, 4) == 0 &&
+                 header->version == ASSET_PACK_VERSION &&
+                 header->count <= (mappedSize - sizeof(AssetPackHeader)) / sizeof(AssetPackEntry);
+    if (valid) {
+        entries = reinterpret_cast<const AssetPackEntry*>(base + sizeof(AssetPackHeader));
+        count = header->count;
+        for (Uint32 i = 0; i < count && valid; ++i) {
+            valid = entries[i].offset <= mappedSize && entries[i].size <= mappedSize - entries[i].offset &&
+                    (i == 0 || entries[i - 1].hash < entries[i].hash);
+        }
+    }
+    if (!valid) {
+        std::cerr << "Error: Invalid asset pack " << filePath << std::endl;
+        Unmount();
+        return false;
+    }
+    return true;
+}
+
+void AssetPack::Unmount() {
+    if (base) {
+#ifdef _WIN32
+        UnmapViewOfFile(base);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(const_cast<Uint8*>(base), mappedSize);
+#endif
+    }
+    base = nullptr;
+    mappedSize = 0;
+    entries = nullptr;
+    count = 0;
+}
+
+const AssetPackEntry* AssetPack::FindEntry(entt::id_type id) {
+    if (!base) return nullptr;
+
+    // El índice está ordenado por hash: búsqueda binaria
+    const AssetPackEntry* end = entries + count;
+    const AssetPackEntry* it = std::lower_bound(entries, end, id, [](const AssetPackEntry& entry, entt::id_type value) {
+        return entry.hash < value;
+    });
+    if (it == end || it->hash != id) return nullptr;
+    return it;
+}
+
+const Uint8* AssetPack::Find(entt::id_type id, Uint32& size) {
+    const AssetPackEntry* entry = FindEntry(id);
+    if (!entry) return nullptr;
+
+    size = entry->size;
+    return base + entry->offset;
+}
+
+SDL_RWops* AssetPack::Open(const char* name) {
+    return Open(entt::hashed_string::value(name), name);
+}
+
+SDL_RWops* AssetPack::Open(entt::id_type id, const char* name) {
+    Uint32 size = 0;
+    const Uint8* data = Find(id, size);
+    if (data) {
+        return SDL_RWFromConstMem(data, static_cast<int>(size));
+    }
+    return SDL_RWFromFile(name, "rb");
+}
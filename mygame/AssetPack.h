@@ -0,0 +1,74 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <SDL_stdinc.h>
+#include <SDL_rwops.h>
+#include <entt/entt.hpp>
+
+// Paquete de recursos: un solo archivo con un índice de (hash del nombre, desplazamiento, tamaño)
+// seguido de los datos de cada recurso. Se mapea en memoria al iniciar y cada recurso se sirve con
+// SDL_RWFromConstMem apuntando directamente al mapeo, sin copias intermedias. El hash es el FNV-1a
+// de 32 bits de entt::hashed_string aplicado al nombre del archivo ("apple.bmp").
+//
+// Disposición (little endian): AssetPackHeader, count AssetPackEntry ordenadas por hash y los datos,
+// cada recurso alineado a ASSET_PACK_ALIGNMENT bytes. Cada entrada lleva también el hash de su
+// contenido, calculado al empaquetar, para que TextureCache detecte cambios sin leer los datos.
+
+const char ASSET_PACK_MAGIC[4] = { 'M', 'G', 'P', 'K' };
+const Uint32 ASSET_PACK_VERSION = 2;
+const Uint32 ASSET_PACK_ALIGNMENT = 16;
+
+struct AssetPackHeader {
+    char magic[4];
+    Uint32 version;
+    Uint32 count;      // Número de entradas del índice
+    Uint32 reserved;
+};
+
+struct AssetPackEntry {
+    Uint32 hash;       // entt::hashed_string del nombre
+    Uint32 offset;     // Desde el principio del archivo
+    Uint32 size;
+    Uint32 contentHash;  // AssetPackContentHash de los datos
+};
+
+// FNV-1a de 32 bits de los bytes de un recurso
+inline Uint32 AssetPackContentHash(const void* data, size_t size) {
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    Uint32 hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+class AssetPack {
+public:
+    // Mapear el paquete. Devuelve false si no existe o no es válido; entonces Open lee archivos sueltos.
+    static bool Mount(const char* filePath);
+    static void Unmount();
+    static bool IsMounted() { return base != nullptr; }
+
+    // Datos de un recurso dentro del mapeo, o nullptr si no está en el paquete
+    static const Uint8* Find(entt::id_type id, Uint32& size);
+    // Entrada del índice de un recurso, o nullptr si no está en el paquete
+    static const AssetPackEntry* FindEntry(entt::id_type id);
+
+    // Abrir un recurso para leerlo con las funciones _RW de SDL: desde el paquete si está montado
+    // y contiene el nombre, si no desde el disco. El mapeo tiene que seguir montado mientras se use.
+    static SDL_RWops* Open(const char* name);
+    // Igual, con el hash ya calculado (por ejemplo en compilación con entt::hashed_string)
+    static SDL_RWops* Open(entt::id_type id, const char* name);
+
+private:
+    static const Uint8* base;
+    static size_t mappedSize;
+    static const AssetPackEntry* entries;
+    static Uint32 count;
+#ifdef _WIN32
+    static void* fileHandle;
+    static void* mappingHandle;
+#endif
+};
+
+#endif // ASSETPACK_H
@@ -0,0 +1,38 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <entt/entt.hpp>
+
+// Manifiesto de recursos: el identificador de cada archivo se calcula en compilación con el
+// FNV-1a de entt::hashed_string, el mismo que usan el paquete de recursos (AssetPack) y las
+// tablas del TextureManager. Cada hashed_string conserva también el nombre para leer el archivo.
+namespace Assets {
+
+constexpr entt::hashed_string BACKGROUND{ "background.bmp" };
+constexpr entt::hashed_string SNAKE_SPRITES{ "snake_sprites.bmp" };
+constexpr entt::hashed_string SNAKE_HEAD_BLINK{ "snake_head_blink.bmp" };
+constexpr entt::hashed_string APPLE{ "apple.bmp" };
+constexpr entt::hashed_string ROCK{ "roca.bmp" };
+constexpr entt::hashed_string EAT_APPLE_SOUND{ "comiendoManzana.wav" };
+constexpr entt::hashed_string BACKGROUND_MUSIC{ "fondo.wav" };
+
+constexpr entt::hashed_string MANIFEST[] = {
+    BACKGROUND, SNAKE_SPRITES, SNAKE_HEAD_BLINK, APPLE, ROCK, EAT_APPLE_SOUND, BACKGROUND_MUSIC
+};
+
+// Dos nombres distintos con el mismo hash serían el mismo recurso para las tablas
+constexpr bool HasUniqueIds() {
+    const int count = sizeof(MANIFEST) / sizeof(MANIFEST[0]);
+    for (int i = 0; i < count; ++i) {
+        for (int j = i + 1; j < count; ++j) {
+            if (MANIFEST[i].value() == MANIFEST[j].value()) return false;
+        }
+    }
+    return true;
+}
+
+static_assert(HasUniqueIds(), "Dos recursos del manifiesto tienen el mismo hash");
+
+} // namespace Assets
+
+#endif // ASSETS_H
@@ -0,0 +1,157 @@
+#include "AudioMixer.h"
+#include <algorithm>
+#include <iostream>
+
+bool AudioMixer::open() {
+    if (device != 0) return true;
+
+    SDL_AudioSpec desired = {};
+    desired.freq = 44100;
+    desired.format = AUDIO_S16SYS;
+    desired.channels = 2;
+    desired.samples = 512;
+    desired.callback = audioCallback;
+    desired.userdata = this;
+
+    // Sin cambios permitidos: si el hardware usa otro formato SDL convierte por nosotros
+    device = SDL_OpenAudioDevice(NULL, 0, &desired, &deviceSpec, 0);
+    if (device == 0) {
+        std::cerr << "Error al abrir el dispositivo de audio: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    mixBuffer.assign(static_cast<size_t>(deviceSpec.samples) * deviceSpec.channels, 0);
+    musicBuffer.assign(mixBuffer.size(), 0);
+    SDL_PauseAudioDevice(device, 0);
+    return true;
+}
+
+void AudioMixer::close() {
+    if (device != 0) {
+        SDL_CloseAudioDevice(device);
+        device = 0;
+    }
+}
+
+bool AudioMixer::play(const Sint16* samples, Uint32 frames, int volume, bool loop) {
+    if (device == 0 || !samples || frames == 0) return false;
+
+    Uint32 tail = requestTail.load(std::memory_order_relaxed);
+    if (tail - requestHead.load(std::memory_order_acquire) >= QUEUE_SIZE) {
+        return false;  // Cola llena: se descarta el sonido
+    }
+
+    requests[tail & (QUEUE_SIZE - 1)] = { samples, frames, volume, loop };
+    requestTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool AudioMixer::play(const SoundBank& bank, int id, int volume, bool loop) {
+    if (id < 0 || id >= bank.size()) return false;
+    return play(bank.samples(id), bank.frames(id), volume, loop);
+}
+
+void AudioMixer::setMusic(MusicStream* stream, int volume) {
+    if (device != 0) SDL_LockAudioDevice(device);
+    music = stream;
+    musicVolume = volume;
+    if (device != 0) SDL_UnlockAudioDevice(device);
+}
+
+void SDLCALL AudioMixer::audioCallback(void* userdata, Uint8* stream, int len) {
+    auto* mixer = static_cast<AudioMixer*>(userdata);
+    mixer->drainRequests();
+
+    const int channels = mixer->deviceSpec.channels;
+    const int bufferFrames = static_cast<int>(mixer->mixBuffer.size()) / channels;
+    Sint16* out = reinterpret_cast<Sint16*>(stream);
+    int frames = len / static_cast<int>(sizeof(Sint16) * channels);
+
+    // Mezclar por bloques del tamaño del acumulador
+    while (frames > 0) {
+        int chunk = std::min(frames, bufferFrames);
+        mixer->mix(out, chunk);
+        out += chunk * channels;
+        frames -= chunk;
+    }
+}
+
+void AudioMixer::drainRequests() {
+    Uint32 head = requestHead.load(std::memory_order_relaxed);
+    Uint32 tail = requestTail.load(std::memory_order_acquire);
+
+    while (head != tail) {
+        startVoice(requests[head & (QUEUE_SIZE - 1)]);
+        ++head;
+    }
+    requestHead.store(head, std::memory_order_release);
+}
+
+void AudioMixer::startVoice(const PlayRequest& request) {
+    // Buscar una voz libre; si no hay, robar la más antigua que no esté en bucle
+    Voice* target = nullptr;
+    for (auto& voice : voices) {
+        if (!voice.active) {
+            target = &voice;
+            break;
+        }
+        if (!voice.loop && (!target || voice.startOrder < target->startOrder)) {
+            target = &voice;
+        }
+    }
+    if (!target) return;  // Todas las voces están en bucle
+
+    target->samples = request.samples;
+    target->frames = request.frames;
+    target->position = 0;
+    target->volume = request.volume;
+    target->loop = request.loop;
+    target->active = true;
+    target->startOrder = voiceCounter++;
+}
+
+void AudioMixer::mix(Sint16* out, int frames) {
+    const int channels = deviceSpec.channels;
+    const int samplesToMix = frames * channels;
+    Sint32* accumulator = mixBuffer.data();
+    std::fill(accumulator, accumulator + samplesToMix, 0);
+
+    for (auto& voice : voices) {
+        if (!voice.active) continue;
+
+        int written = 0;
+        while (written < frames && voice.active) {
+            Uint32 available = voice.frames - voice.position;
+            int count = static_cast<int>(std::min<Uint32>(available, static_cast<Uint32>(frames - written)));
+            const Sint16* src = voice.samples + static_cast<size_t>(voice.position) * channels;
+            Sint32* dst = accumulator + written * channels;
+
+            for (int i = 0; i < count * channels; ++i) {
+                dst[i] += (src[i] * voice.volume) / SDL_MIX_MAXVOLUME;
+            }
+
+            written += count;
+            voice.position += count;
+            if (voice.position >= voice.frames) {
+                if (voice.loop) {
+                    voice.position = 0;
+                } else {
+                    voice.active = false;
+                }
+            }
+        }
+    }
+
+    // La música se lee del doble buffer de MusicStream; si no llega a tiempo suena silencio
+    if (music) {
+        int musicFrames = music->read(musicBuffer.data(), frames);
+        for (int i = 0; i < musicFrames * channels; ++i) {
+            accumulator[i] += (musicBuffer[i] * musicVolume) / SDL_MIX_MAXVOLUME;
+        }
+    }
+
+    // Saturar al rango de 16 bits
+    for (int i = 0; i < samplesToMix; ++i) {
+        out[i] = static_cast<Sint16>(std::max(-32768, std::min(32767, accumulator[i])));
+    }
+}
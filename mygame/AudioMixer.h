@@ -0,0 +1,79 @@
+#ifndef AUDIOMIXER_H
+#define AUDIOMIXER_H
+
+#include <SDL.h>
+#include "MusicStream.h"
+#include "SoundBank.h"
+#include <atomic>
+#include <vector>
+
+// Mezclador de audio: un único dispositivo abierto al iniciar, alimentado por un callback que
+// mezcla un conjunto fijo de voces. El hilo del juego pide sonidos con play(), que solo escribe
+// en una cola sin bloqueos y sin reservar memoria; el callback la vacía al principio de cada
+// bloque. Si no queda ninguna voz libre se roba la más antigua que no esté en bucle.
+class AudioMixer {
+public:
+    static const int MAX_VOICES = 16;     // Voces que pueden sonar a la vez
+    static const int QUEUE_SIZE = 64;     // Peticiones pendientes (potencia de dos)
+
+    AudioMixer() = default;
+    ~AudioMixer() { close(); }
+
+    // Abrir el dispositivo en formato de 16 bits estéreo a 44.1 kHz y empezar a mezclar
+    bool open();
+    void close();
+
+    // Formato real del dispositivo; los sonidos deben estar ya convertidos a él
+    const SDL_AudioSpec& spec() const { return deviceSpec; }
+
+    // Reproducir frames muestras por canal desde samples. Devuelve false si la cola está llena.
+    bool play(const Sint16* samples, Uint32 frames, int volume = SDL_MIX_MAXVOLUME, bool loop = false);
+
+    // Reproducir un sonido del banco por su identificador
+    bool play(const SoundBank& bank, int id, int volume = SDL_MIX_MAXVOLUME, bool loop = false);
+
+    // Mezclar una música en streaming (nullptr para quitarla). Bloquea el callback un instante,
+    // así que no hay que llamarla en cada frame.
+    void setMusic(MusicStream* stream, int volume = SDL_MIX_MAXVOLUME);
+
+private:
+    struct PlayRequest {
+        const Sint16* samples;
+        Uint32 frames;
+        int volume;
+        bool loop;
+    };
+
+    struct Voice {
+        const Sint16* samples = nullptr;
+        Uint32 frames = 0;
+        Uint32 position = 0;   // Frame siguiente a reproducir
+        int volume = 0;
+        bool loop = false;
+        bool active = false;
+        Uint64 startOrder = 0; // Orden de inicio, para robar la voz más antigua
+    };
+
+    static void SDLCALL audioCallback(void* userdata, Uint8* stream, int len);
+    void drainRequests();
+    void startVoice(const PlayRequest& request);
+    void mix(Sint16* out, int frames);
+
+    SDL_AudioDeviceID device = 0;
+    SDL_AudioSpec deviceSpec = {};
+
+    // Cola de un productor (juego) y un consumidor (callback de audio)
+    PlayRequest requests[QUEUE_SIZE];
+    std::atomic<Uint32> requestHead{0};  // Siguiente petición a leer (la escribe el callback)
+    std::atomic<Uint32> requestTail{0};  // Siguiente hueco a escribir (lo escribe el juego)
+
+    // Estado que solo toca el callback
+    Voice voices[MAX_VOICES];
+    Uint64 voiceCounter = 0;
+    std::vector<Sint32> mixBuffer;  // Acumulador reservado en open()
+    MusicStream* music = nullptr;
+    int musicVolume = 0;
+    std::vector<Sint16> musicBuffer;  // Trozo de música del bloque actual, reservado en open()
+};
+
+#endif // AUDIOMIXER_H
@@ -0,0 +1,213 @@
+#include "BatchSimulator.h"
+
+// Desplazamiento por dirección, en el mismo orden que Direction (UP, DOWN, LEFT, RIGHT)
+static const Sint16 DIRECTION_DX[4] = { 0, 0, -1, 1 };
+static const Sint16 DIRECTION_DY[4] = { -1, 1, 0, 0 };
+
+BatchSimulator::BatchSimulator(int gameCount, Uint64 seed, int width, int height)
+    : count(gameCount), boardWidth(width), boardHeight(height), cellCount(width * height),
+      headXs(gameCount), headYs(gameCount), directions(gameCount), growFlags(gameCount),
+      appleCells(gameCount), rockTicks(gameCount), rockCells(gameCount * 3), rockCounts(gameCount),
+      lengths(gameCount), ringHeads(gameCount), freeCounts(gameCount), rngs(gameCount),
+      cells(static_cast<size_t>(gameCount) * cellCount), bodies(static_cast<size_t>(gameCount) * cellCount),
+      freeCells(static_cast<size_t>(gameCount) * cellCount), freeSlots(static_cast<size_t>(gameCount) * cellCount),
+      nextXs(gameCount), nextYs(gameCount) {
+    // Cada partida recibe una secuencia independiente, separada de la anterior con jump()
+    Rng streams(seed);
+    for (int game = 0; game < count; ++game) {
+        rngs[game] = streams;
+        streams.jump();
+        reset(game);
+    }
+}
+
+void BatchSimulator::occupy(int game, int cell, Uint8 flags) {
+    Uint8* cellsOfGame = board(game);
+    if (cellsOfGame[cell] == CELL_EMPTY) {
+        // Quitar la celda del conjunto de libres intercambiándola con la última
+        size_t base = static_cast<size_t>(game) * cellCount;
+        Uint16 slot = freeSlots[base + cell];
+        Uint16 last = freeCells[base + freeCounts[game] - 1];
+        freeCells[base + slot] = last;
+        freeSlots[base + last] = slot;
+        --freeCounts[game];
+    }
+    cellsOfGame[cell] |= flags;
+}
+
+void BatchSimulator::release(int game, int cell, Uint8 flags) {
+    Uint8* cellsOfGame = board(game);
+    if (cellsOfGame[cell] == CELL_EMPTY) return;
+    cellsOfGame[cell] &= ~flags;
+    if (cellsOfGame[cell] == CELL_EMPTY) {
+        size_t base = static_cast<size_t>(game) * cellCount;
+        freeSlots[base + cell] = static_cast<Uint16>(freeCounts[game]);
+        freeCells[base + freeCounts[game]] = static_cast<Uint16>(cell);
+        ++freeCounts[game];
+    }
+}
+
+bool BatchSimulator::randomFreeCell(int game, int& cell) {
+    if (freeCounts[game] == 0) return false;
+    size_t base = static_cast<size_t>(game) * cellCount;
+    cell = freeCells[base + rngs[game].below(freeCounts[game])];
+    return true;
+}
+
+void BatchSimulator::generateRocks(int game) {
+    Uint16* rocks = &rockCells[game * 3];
+
+    // Liberar las celdas de las rocas anteriores
+    for (int i = 0; i < rockCounts[game]; ++i) {
+        release(game, rocks[i], CELL_ROCK);
+    }
+    rockCounts[game] = 0;
+
+    // Mismo criterio que GenerateRock: primer tile libre al azar y los otros dos libres
+    // en horizontal o vertical
+    const Uint8* cellsOfGame = board(game);
+    for (int attempt = 0; attempt < ROCK_PLACEMENT_ATTEMPTS && rockCounts[game] == 0; ++attempt) {
+        int start;
+        if (!randomFreeCell(game, start)) {
+            break;  // Tablero lleno
+        }
+
+        int x = start % boardWidth;
+        int y = start / boardWidth;
+        bool horizontal = rngs[game].below(2) == 0;
+        for (int orientation = 0; orientation < 2; ++orientation, horizontal = !horizontal) {
+            int step = horizontal ? 1 : boardWidth;
+            if (horizontal ? x + 2 >= boardWidth : y + 2 >= boardHeight) continue;
+
+            if (cellsOfGame[start + step] == CELL_EMPTY && cellsOfGame[start + 2 * step] == CELL_EMPTY) {
+                rocks[0] = static_cast<Uint16>(start);
+                rocks[1] = static_cast<Uint16>(start + step);
+                rocks[2] = static_cast<Uint16>(start + 2 * step);
+                rockCounts[game] = 3;
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < rockCounts[game]; ++i) {
+        occupy(game, rocks[i], CELL_ROCK);
+    }
+}
+
+void BatchSimulator::reset(int game) {
+    size_t base = static_cast<size_t>(game) * cellCount;
+
+    // Vaciar el tablero
+    for (int cell = 0; cell < cellCount; ++cell) {
+        cells[base + cell] = CELL_EMPTY;
+        freeCells[base + cell] = static_cast<Uint16>(cell);
+        freeSlots[base + cell] = static_cast<Uint16>(cell);
+    }
+    freeCounts[game] = static_cast<Uint32>(cellCount);
+
+    // Serpiente de un segmento en el centro, mirando a la derecha
+    headXs[game] = static_cast<Sint16>(boardWidth / 2);
+    headYs[game] = static_cast<Sint16>(boardHeight / 2);
+    directions[game] = RIGHT;
+    growFlags[game] = 0;
+    lengths[game] = 1;
+    ringHeads[game] = 0;
+    int head = headYs[game] * boardWidth + headXs[game];
+    bodies[base] = static_cast<Uint16>(head);
+    occupy(game, head, CELL_HEAD);
+
+    // Manzana en la misma celda inicial que CreateGame (160, 160) si cabe en el tablero
+    int apple = (160 / TILE_SIZE) * boardWidth + 160 / TILE_SIZE;
+    if (160 / TILE_SIZE >= boardWidth || 160 / TILE_SIZE >= boardHeight || cells[base + apple] != CELL_EMPTY) {
+        randomFreeCell(game, apple);
+    }
+    appleCells[game] = static_cast<Uint16>(apple);
+    occupy(game, apple, CELL_APPLE);
+
+    rockTicks[game] = 0;
+    rockCounts[game] = 0;
+    generateRocks(game);
+}
+
+void BatchSimulator::step(const Uint8* actions) {
+    const int n = count;
+    const Sint16 lastColumn = static_cast<Sint16>(boardWidth - 1);
+    const Sint16 lastRow = static_cast<Sint16>(boardHeight - 1);
+    Uint8* dirs = directions.data();
+    const Sint16* hx = headXs.data();
+    const Sint16* hy = headYs.data();
+    Sint16* nx = nextXs.data();
+    Sint16* ny = nextYs.data();
+
+    // Fase 1: aplicar las acciones, rechazando la media vuelta (UP^1 = DOWN, LEFT^1 = RIGHT).
+    // Bucle sin saltos sobre arreglos contiguos, apto para vectorizar.
+    for (int i = 0; i < n; ++i) {
+        Uint8 action = actions[i] & 3;
+        dirs[i] = action != (dirs[i] ^ 1) ? action : dirs[i];
+    }
+
+    // Fase 2: calcular la siguiente posición de cada cabeza dando la vuelta en los bordes
+    for (int i = 0; i < n; ++i) {
+        Sint16 x = static_cast<Sint16>(hx[i] + DIRECTION_DX[dirs[i]]);
+        Sint16 y = static_cast<Sint16>(hy[i] + DIRECTION_DY[dirs[i]]);
+        x = x < 0 ? lastColumn : (x > lastColumn ? 0 : x);
+        y = y < 0 ? lastRow : (y > lastRow ? 0 : y);
+        nx[i] = x;
+        ny[i] = y;
+    }
+
+    // Fase 3: actualizar cuerpo, tablero y eventos de cada partida
+    for (int game = 0; game < n; ++game) {
+        size_t base = static_cast<size_t>(game) * cellCount;
+        Uint8* cellsOfGame = &cells[base];
+        Uint16* body = &bodies[base];
+
+        int oldHead = headYs[game] * boardWidth + headXs[game];
+        int newHead = ny[game] * boardWidth + nx[game];
+
+        // La antigua cabeza pasa a ser cuerpo
+        cellsOfGame[oldHead] = static_cast<Uint8>((cellsOfGame[oldHead] & ~CELL_HEAD) | CELL_BODY);
+        ringHeads[game] = ringHeads[game] == 0 ? cellCount - 1 : ringHeads[game] - 1;
+        body[ringHeads[game]] = static_cast<Uint16>(newHead);
+        ++lengths[game];
+
+        // Sin crecimiento se libera la cola
+        if (growFlags[game]) {
+            growFlags[game] = 0;
+        } else {
+            Uint32 tailIndex = ringHeads[game] + lengths[game] - 1;
+            if (tailIndex >= static_cast<Uint32>(cellCount)) tailIndex -= cellCount;
+            release(game, body[tailIndex], CELL_BODY);
+            --lengths[game];
+        }
+        occupy(game, newHead, CELL_HEAD);
+        headXs[game] = nx[game];
+        headYs[game] = ny[game];
+
+        // Manzana: crecer en el próximo movimiento y colocar otra en una celda libre
+        if (cellsOfGame[newHead] & CELL_APPLE) {
+            ++applesEaten;
+            growFlags[game] = 1;
+            release(game, newHead, CELL_APPLE);
+            int apple;
+            if (randomFreeCell(game, apple)) {
+                appleCells[game] = static_cast<Uint16>(apple);
+                occupy(game, apple, CELL_APPLE);
+            }
+        }
+
+        // Rocas: cambiar de lugar cada ROCK_TICKS
+        if (++rockTicks[game] >= ROCK_TICKS) {
+            generateRocks(game);
+            rockTicks[game] = 0;
+        }
+
+        // Choque con el cuerpo o con una roca: la partida termina y empieza otra
+        if (cellsOfGame[newHead] & (CELL_BODY | CELL_ROCK)) {
+            ++gamesFinished;
+            reset(game);
+        }
+    }
+
+    totalSteps += static_cast<Uint64>(n);
+}
@@ -0,0 +1,78 @@
+#ifndef BATCHSIMULATOR_H
+#define BATCHSIMULATOR_H
+
+// Simulador por lotes: miles de partidas independientes avanzadas a la vez.
+// El estado se guarda como estructura de arreglos (un arreglo por campo, una entrada por
+// partida) para que las fases de cálculo recorran memoria contigua sin saltos. Las reglas
+// son las mismas que UpdateSnakeMovement, CheckCollisionWithApple, UpdateRockMovement,
+// CheckSelfCollision y CheckCollisionWithRock de Game.cpp.
+#include "Game.h"
+#include <vector>
+
+class BatchSimulator {
+public:
+    // Tableros de hasta 65536 celdas (los índices de celda son de 16 bits)
+    BatchSimulator(int gameCount, Uint64 seed, int width = GRID_WIDTH, int height = GRID_HEIGHT);
+
+    // Avanzar todas las partidas un tick. actions[i] es la dirección pedida para la partida i
+    // (se ignora si da media vuelta). Las partidas que terminan se reinician solas.
+    void step(const Uint8* actions);
+
+    // Reiniciar una partida
+    void reset(int game);
+
+    int gameCount() const { return count; }
+    int width() const { return boardWidth; }
+    int height() const { return boardHeight; }
+
+    // Consultas para los bots
+    int headX(int game) const { return headXs[game]; }
+    int headY(int game) const { return headYs[game]; }
+    int appleCell(int game) const { return appleCells[game]; }
+    Direction direction(int game) const { return static_cast<Direction>(directions[game]); }
+    Uint32 length(int game) const { return lengths[game]; }
+    Uint8 cellAt(int game, int cell) const { return cells[static_cast<size_t>(game) * cellCount + cell]; }
+
+    // Estadísticas acumuladas de todas las partidas
+    Uint64 totalSteps = 0;     // Ticks de partida ejecutados (partidas x llamadas a step)
+    Uint64 gamesFinished = 0;  // Partidas terminadas por choque
+    Uint64 applesEaten = 0;    // Manzanas comidas
+
+private:
+    Uint8* board(int game) { return &cells[static_cast<size_t>(game) * cellCount]; }
+    void occupy(int game, int cell, Uint8 flags);
+    void release(int game, int cell, Uint8 flags);
+    bool randomFreeCell(int game, int& cell);
+    void generateRocks(int game);
+
+    int count;
+    int boardWidth;
+    int boardHeight;
+    int cellCount;
+
+    // Estado por partida
+    std::vector<Sint16> headXs;       // Columna de la cabeza
+    std::vector<Sint16> headYs;       // Fila de la cabeza
+    std::vector<Uint8> directions;    // Dirección de la cabeza
+    std::vector<Uint8> growFlags;     // La serpiente crece en el próximo movimiento
+    std::vector<Uint16> appleCells;   // Celda de la manzana
+    std::vector<Uint16> rockTicks;    // Ticks desde el último cambio de las rocas
+    std::vector<Uint16> rockCells;    // Tres celdas de roca por partida
+    std::vector<Uint8> rockCounts;    // Número de rocas colocadas (0 o 3)
+    std::vector<Uint32> lengths;      // Longitud de la serpiente
+    std::vector<Uint32> ringHeads;    // Índice de la cabeza en el buffer circular del cuerpo
+    std::vector<Uint32> freeCounts;   // Número de celdas libres
+    std::vector<Rng> rngs;            // Generador aleatorio de cada partida (secuencias independientes)
+
+    // Estado por partida y celda (cellCount entradas por partida)
+    std::vector<Uint8> cells;         // Ocupación del tablero (CellFlags)
+    std::vector<Uint16> bodies;       // Buffer circular con las celdas del cuerpo
+    std::vector<Uint16> freeCells;    // Celdas libres, sin orden
+    std::vector<Uint16> freeSlots;    // Posición de cada celda en freeCells
+
+    // Resultados intermedios de un paso
+    std::vector<Sint16> nextXs;
+    std::vector<Sint16> nextYs;
+};
+
+#endif // BATCHSIMULATOR_H
@@ -0,0 +1,103 @@
+#include "FramePacer.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <iostream>
+
+void FramePacer::configure(PacingMode mode, int fps) {
+    pacingMode = mode;
+    targetFps = fps;
+}
+
+Uint32 FramePacer::rendererFlags() const {
+    return pacingMode == PACING_VSYNC ? SDL_RENDERER_PRESENTVSYNC : 0;
+}
+
+void FramePacer::attach(SDL_Window* window, SDL_Renderer* renderer) {
+    frequency = SDL_GetPerformanceFrequency();
+
+    // Frecuencia de la pantalla: presupuesto con vsync y objetivo por defecto sin ella
+    int refreshRate = 0;
+    SDL_DisplayMode displayMode;
+    if (SDL_GetWindowDisplayMode(window, &displayMode) == 0) {
+        refreshRate = displayMode.refresh_rate;
+    }
+    if (refreshRate <= 0) refreshRate = DEFAULT_FPS;
+
+    if (pacingMode == PACING_VSYNC) {
+        SDL_RendererInfo info;
+        if (SDL_GetRendererInfo(renderer, &info) != 0 || !(info.flags & SDL_RENDERER_PRESENTVSYNC)) {
+            std::cerr << "Warning: vsync unavailable, pacing to " << refreshRate << " FPS with a timer" << std::endl;
+            pacingMode = PACING_TARGET_FPS;
+            targetFps = 0;
+        }
+    }
+    if (pacingMode != PACING_TARGET_FPS || targetFps <= 0) {
+        targetFps = refreshRate;
+    }
+
+    frameTicks = frequency / static_cast<Uint64>(targetFps);
+    sleepMargin = frequency / 500;  // 2 ms al principio; se ajusta con cada SDL_Delay
+    nextDeadline = 0;
+}
+
+void FramePacer::beginFrame() {
+    frameStart = SDL_GetPerformanceCounter();
+
+    // Los plazos avanzan de frameTicks en frameTicks para no acumular deriva; si el juego se ha
+    // retrasado más de un frame entero se vuelve a empezar desde ahora
+    if (nextDeadline == 0 || frameStart >= nextDeadline + frameTicks) {
+        nextDeadline = frameStart;
+    }
+    nextDeadline += frameTicks;
+}
+
+void FramePacer::endFrame() {
+    Uint64 workEnd = SDL_GetPerformanceCounter();
+    Uint64 work = workEnd - frameStart;  // Con vsync incluye la espera de SDL_RenderPresent
+    ++frameStats.frames;
+    frameStats.workTicks += work;
+
+    switch (pacingMode) {
+        case PACING_VSYNC:
+            if (work > frameTicks + frameTicks / 2) ++frameStats.framesOverBudget;  // Se perdió un refresco
+            // Con la ventana minimizada SDL_RenderPresent puede volver sin esperar; entonces se
+            // duerme como si no hubiera vsync para no girar en vacío
+            if (work < frameTicks / 2) waitUntil(frameStart + frameTicks);
+            break;
+        case PACING_TARGET_FPS:
+            if (work > frameTicks) ++frameStats.framesOverBudget;
+            waitUntil(nextDeadline);
+            break;
+        case PACING_UNCAPPED:
+            break;
+    }
+}
+
+void FramePacer::waitUntil(Uint64 deadline) {
+    PROFILE_SCOPE("FramePacer::waitUntil");
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // Dormir mientras quede más que el margen
+    while (now < deadline && deadline - now > sleepMargin) {
+        Uint32 ms = static_cast<Uint32>((deadline - now - sleepMargin) * 1000 / frequency);
+        if (ms == 0) break;
+
+        SDL_Delay(ms);
+        Uint64 woke = SDL_GetPerformanceCounter();
+        frameStats.sleepTicks += woke - now;
+
+        // Ajustar el margen: sube enseguida al mayor exceso visto y baja poco a poco
+        Uint64 requested = ms * frequency / 1000;
+        Uint64 overshoot = woke - now > requested ? woke - now - requested : 0;
+        Uint64 minimum = frequency / 4000;  // 0.25 ms
+        sleepMargin = std::max(minimum, std::max(overshoot, sleepMargin - sleepMargin / 16));
+        now = woke;
+    }
+
+    // El último tramo se espera activamente, que es preciso
+    Uint64 spinStart = now;
+    while (now < deadline) {
+        now = SDL_GetPerformanceCounter();
+    }
+    frameStats.spinTicks += now - spinStart;
+}
@@ -0,0 +1,65 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <SDL.h>
+
+// Modos de ritmo del bucle principal
+enum PacingMode {
+    PACING_VSYNC,       // SDL_RenderPresent espera al refresco de la pantalla
+    PACING_TARGET_FPS,  // Dormir hasta el siguiente frame y esperar activamente el último tramo
+    PACING_UNCAPPED     // Sin límite (para medir)
+};
+
+// Contadores del ritmo de frames, en ticks de SDL_GetPerformanceCounter
+struct FramePacerStats {
+    Uint64 frames = 0;
+    Uint64 framesOverBudget = 0;  // Frames cuyo trabajo no cupo en el presupuesto
+    Uint64 workTicks = 0;         // Tiempo dedicado a simular y dibujar
+    Uint64 sleepTicks = 0;        // Tiempo dormido (sin gastar CPU)
+    Uint64 spinTicks = 0;         // Tiempo esperando activamente el final del frame
+};
+
+// Ritmo de frames: limita el bucle principal a la frecuencia de la pantalla o a una frecuencia
+// fija para no redibujar la misma escena miles de veces por segundo. El presupuesto de cada frame
+// es 1 / fps; lo que sobra tras el trabajo se pasa durmiendo con SDL_Delay y, como el sueño del
+// sistema no es preciso, el último tramo (sleepMargin) se espera activamente. El margen se ajusta
+// solo según lo que se pasa cada SDL_Delay, así que en sistemas con temporizadores finos casi no
+// se gasta CPU esperando.
+//
+// Uso: rendererFlags() al crear el renderer, attach() después y beginFrame()/endFrame() alrededor
+// de cada frame (endFrame() tras SDL_RenderPresent).
+class FramePacer {
+public:
+    static const int DEFAULT_FPS = 60;  // Si la pantalla no informa de su frecuencia
+
+    // targetFps solo se usa en PACING_TARGET_FPS; con 0 se toma la frecuencia de la pantalla
+    void configure(PacingMode mode, int targetFps = 0);
+
+    // Banderas adicionales para SDL_CreateRenderer
+    Uint32 rendererFlags() const;
+
+    // Comprobar el renderer creado; si no ha aceptado la sincronía vertical se pasa a
+    // PACING_TARGET_FPS con la frecuencia de la pantalla
+    void attach(SDL_Window* window, SDL_Renderer* renderer);
+
+    void beginFrame();
+    void endFrame();
+
+    PacingMode mode() const { return pacingMode; }
+    int fps() const { return targetFps; }
+    const FramePacerStats& stats() const { return frameStats; }
+
+private:
+    void waitUntil(Uint64 deadline);
+
+    PacingMode pacingMode = PACING_VSYNC;
+    int targetFps = 0;
+    Uint64 frequency = 0;
+    Uint64 frameTicks = 0;     // Presupuesto de un frame
+    Uint64 frameStart = 0;
+    Uint64 nextDeadline = 0;   // Final previsto del frame actual
+    Uint64 sleepMargin = 0;    // Tramo final que se espera activamente
+    FramePacerStats frameStats;
+};
+
+#endif // FRAMEPACER_H
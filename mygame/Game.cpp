@@ -0,0 +1,246 @@
+#include "Game.h"
+#include "Profiler.h"
+
+Direction OppositeDirection(Direction direction) {
+    switch (direction) {
+        case UP:
+            return DOWN;
+        case DOWN:
+            return UP;
+        case LEFT:
+            return RIGHT;
+        case RIGHT:
+        default:
+            return LEFT;
+    }
+}
+
+SDL_Point NextHeadPosition(SDL_Point head, Direction direction, int speed) {
+    // Mover la cabeza según la dirección
+    switch (direction) {
+        case UP:
+            head.y -= speed;
+            break;
+        case DOWN:
+            head.y += speed;
+            break;
+        case LEFT:
+            head.x -= speed;
+            break;
+        case RIGHT:
+            head.x += speed;
+            break;
+    }
+
+    // Asegurar que la serpiente no salga de los bordes de la pantalla
+    if (head.x < 0) head.x = SCREEN_WIDTH - TILE_SIZE;
+    if (head.x >= SCREEN_WIDTH) head.x = 0;
+    if (head.y < 0) head.y = SCREEN_HEIGHT - TILE_SIZE;
+    if (head.y >= SCREEN_HEIGHT) head.y = 0;
+
+    return head;
+}
+
+// Sistema de generación de rocas
+void GenerateRock(entt::registry& registry) {
+    if (registry.view<Rock>().empty()) {
+        registry.emplace<Rock>(registry.create());
+    }
+
+    auto rockEntity = registry.view<Rock>().front();
+    auto& rock = registry.get<Rock>(rockEntity);
+    auto boardEntity = registry.view<Board>().front();
+    auto& board = registry.get<Board>(boardEntity);
+    auto& rng = registry.get<Rng>(boardEntity);
+
+    // Liberar las celdas de las rocas anteriores
+    for (const auto& pos : rock.positions) {
+        board.clear(pos, CELL_ROCK);
+    }
+    rock.positions.clear();
+
+    // Elegir el primer tile entre las celdas libres y colocar los tres tiles consecutivos
+    // en dirección horizontal o vertical, siempre que los otros dos también estén libres
+    for (int attempt = 0; attempt < ROCK_PLACEMENT_ATTEMPTS && rock.positions.empty(); ++attempt) {
+        SDL_Point start;
+        if (!board.randomFreeCell(rng, start)) {
+            break;  // Tablero lleno
+        }
+
+        bool horizontal = rng.below(2) == 0;
+        for (int orientation = 0; orientation < 2; ++orientation, horizontal = !horizontal) {
+            SDL_Point step = horizontal ? SDL_Point{TILE_SIZE, 0} : SDL_Point{0, TILE_SIZE};
+            SDL_Point last = { start.x + 2 * step.x, start.y + 2 * step.y };
+            if (last.x >= SCREEN_WIDTH || last.y >= SCREEN_HEIGHT) continue;
+
+            SDL_Point middle = { start.x + step.x, start.y + step.y };
+            if (board.isFree(middle) && board.isFree(last)) {
+                rock.positions.push_back(start);
+                rock.positions.push_back(middle);
+                rock.positions.push_back(last);
+                break;
+            }
+        }
+    }
+
+    for (const auto& pos : rock.positions) {
+        board.set(pos, CELL_ROCK);
+    }
+    ++rock.version;
+}
+
+
+// Sistema de actualización para cambiar las rocas de lugar cada 15 segundos
+void UpdateRockMovement(entt::registry& registry) {
+    PROFILE_SCOPE("UpdateRockMovement");
+    auto view = registry.view<Rock>();
+
+    for (auto entity : view) {
+        auto& rock = view.get<Rock>(entity);
+        if (++rock.ticks >= ROCK_TICKS) {
+            // Cambiar la posición de las rocas después de 15 segundos
+            GenerateRock(registry);
+            rock.ticks = 0;  // Reiniciar el contador
+        }
+    }
+}
+
+// Verificar colisión entre la serpiente y las rocas
+bool CheckCollisionWithRock(const SnakeBody& snake, const Board& board) {
+    PROFILE_SCOPE("CheckCollisionWithRock");
+    // Las rocas están marcadas en el tablero, basta con mirar la celda de la cabeza
+    return board.has(snake.segmentAt(0), CELL_ROCK);
+}
+
+// Sistema de actualización del movimiento de la serpiente: avanza una celda por tick
+void UpdateSnakeMovement(entt::registry& registry) {
+    PROFILE_SCOPE("UpdateSnakeMovement");
+    auto view = registry.view<SnakeBody>();
+    auto& board = registry.get<Board>(registry.view<Board>().front());
+
+    for (auto entity : view) {
+        auto& snake = view.get<SnakeBody>(entity);
+
+        SDL_Point newHead = NextHeadPosition(snake.segmentAt(0), snake.direction, snake.speed);
+
+        // La antigua cabeza pasa a ser el primer segmento del cuerpo y sigue la dirección actual
+        board.clear(snake.segmentAt(0), CELL_HEAD);
+        board.set(snake.segmentAt(0), CELL_BODY);
+        snake.directionAt(0) = snake.direction;
+        snake.pushHead(newHead, snake.direction);
+
+        // Sin crecimiento se descarta la cola; al crecer se conserva y la serpiente gana un segmento
+        if (snake.grow) {
+            snake.prevTail = snake.segmentAt(snake.size() - 1);  // La cola no se movió
+            snake.grow = false;
+        } else {
+            snake.prevTail = snake.segmentAt(snake.size() - 1);
+            board.clear(snake.prevTail, CELL_BODY);
+            snake.popTail();
+        }
+        board.set(newHead, CELL_HEAD);
+    }
+}
+
+// Sistema para verificar la colisión entre la serpiente y la manzana
+bool CheckCollisionWithApple(entt::registry& registry, int& appleCounter) {
+    PROFILE_SCOPE("CheckCollisionWithApple");
+    auto snakeView = registry.view<SnakeBody>();
+    auto appleView = registry.view<Apple>();
+    auto boardEntity = registry.view<Board>().front();
+    auto& board = registry.get<Board>(boardEntity);
+    auto& rng = registry.get<Rng>(boardEntity);
+    bool eaten = false;
+
+    for (auto snakeEntity : snakeView) {
+        auto& snake = snakeView.get<SnakeBody>(snakeEntity);
+
+        // Si la celda de la cabeza no tiene manzana no hace falta revisar ninguna
+        if (!board.has(snake.segmentAt(0), CELL_APPLE)) {
+            continue;
+        }
+
+        for (auto appleEntity : appleView) {
+            auto& apple = appleView.get<Apple>(appleEntity);
+
+            if (Board::indexOf(snake.segmentAt(0)) == Board::indexOf(apple.position)) {
+                ++appleCounter;
+                snake.grow = true;
+                eaten = true;
+
+                // Generar nueva manzana en una celda libre (nunca sobre la serpiente ni las rocas)
+                board.clear(apple.position, CELL_APPLE);
+                if (board.randomFreeCell(rng, apple.position)) {
+                    board.set(apple.position, CELL_APPLE);
+                }
+            }
+        }
+    }
+    return eaten;
+}
+
+// Sistema para verificar colisión con el cuerpo de la serpiente
+bool CheckSelfCollision(const SnakeBody& snake, const Board& board) {
+    PROFILE_SCOPE("CheckSelfCollision");
+    // La cabeza choca si su celda también está marcada como cuerpo. El segmento que sigue
+    // a la cabeza nunca puede compartir su celda, y la cola ya se liberó al moverse.
+    return board.has(snake.segmentAt(0), CELL_BODY);
+}
+
+entt::entity CreateGame(entt::registry& registry, const Rng& rng) {
+    // Crear el tablero de ocupación con el generador aleatorio de la partida
+    auto boardEntity = registry.create();
+    auto& board = registry.emplace<Board>(boardEntity);
+    registry.emplace<Rng>(boardEntity, rng);
+
+    // Crear la serpiente en el centro del tablero
+    auto snakeEntity = registry.create();
+    auto& snake = registry.emplace<SnakeBody>(snakeEntity);
+    snake.direction = RIGHT;
+    snake.pushHead({(GRID_WIDTH / 2) * TILE_SIZE, (GRID_HEIGHT / 2) * TILE_SIZE}, RIGHT);
+    snake.prevTail = snake.segmentAt(0);
+    board.set(snake.segmentAt(0), CELL_HEAD);
+
+    // Crear la manzana
+    auto appleEntity = registry.create();
+    registry.emplace<Apple>(appleEntity, SDL_Point{160, 160});
+    board.set(SDL_Point{160, 160}, CELL_APPLE);
+
+    // Crear la entidad para las rocas
+    GenerateRock(registry);  // Inicializar las primeras rocas
+
+    return snakeEntity;
+}
+
+int SimulationTick(entt::registry& registry, int& appleCounter) {
+    PROFILE_SCOPE("SimulationTick");
+    int events = TICK_NONE;
+
+    // Actualizar el movimiento de la serpiente
+    UpdateSnakeMovement(registry);
+
+    // Verificar colisión con la manzana
+    if (CheckCollisionWithApple(registry, appleCounter)) {
+        events |= TICK_APPLE_EATEN;
+    }
+
+    // Actualizar y mover las rocas cada 15 segundos
+    UpdateRockMovement(registry);
+
+    auto& board = registry.get<Board>(registry.view<Board>().front());
+    for (auto entity : registry.view<SnakeBody>()) {
+        auto& snake = registry.get<SnakeBody>(entity);
+
+        // Verificar colisión con el cuerpo
+        if (CheckSelfCollision(snake, board)) {
+            events |= TICK_HIT_SELF;
+        }
+
+        // Verificar colisión con las rocas
+        if (CheckCollisionWithRock(snake, board)) {
+            events |= TICK_HIT_ROCK;
+        }
+    }
+
+    return events;
+}
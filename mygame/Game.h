@@ -0,0 +1,189 @@
+#ifndef GAME_H
+#define GAME_H
+
+// Lógica del juego (componentes y sistemas de simulación). No depende del video ni del
+// audio de SDL, así que se puede ejecutar sin ventana (ver headless.cpp).
+#include <SDL_rect.h>
+#include <entt/entt.hpp>
+#include "Random.h"
+#include <vector>
+#include <cstdlib>
+
+// Definiciones de constantes
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int TILE_SIZE = 32;
+const Uint32 TICK_MS = 150;      // Duración fija de un tick de simulación (un paso de la serpiente)
+const int ROCK_TICKS = 15000 / TICK_MS;  // Ticks entre cambios de lugar de las rocas (15 segundos)
+const int GRID_WIDTH = SCREEN_WIDTH / TILE_SIZE;    // Columnas del tablero
+const int GRID_HEIGHT = SCREEN_HEIGHT / TILE_SIZE;  // Filas del tablero
+const int ROCK_PLACEMENT_ATTEMPTS = 32;  // Intentos para encontrar hueco a las rocas
+
+// Direcciones de movimiento
+enum Direction { UP, DOWN, LEFT, RIGHT };
+
+// Componente para manejar la serpiente
+// Los segmentos viven en un buffer circular: mover la serpiente escribe una cabeza nueva
+// y descarta (o conserva, si crece) la cola, así que cada movimiento cuesta O(1).
+struct SnakeBody {
+    std::vector<SDL_Point> segments;  // Buffer circular con las posiciones de los segmentos
+    std::vector<Direction> directions; // Buffer circular con la dirección de cada segmento
+    size_t head = 0;                  // Índice de la cabeza dentro del buffer
+    size_t length = 0;                // Número de segmentos de la serpiente
+    Direction direction = RIGHT;      // Dirección de movimiento de la cabeza
+    int speed = TILE_SIZE;            // Velocidad de la serpiente
+    bool grow = false;                // Indica si la serpiente debe crecer
+    SDL_Point prevTail = { 0, 0 };    // Posición de la cola antes del último movimiento (para interpolar)
+
+    size_t size() const { return length; }
+
+    // Segmento i contando desde la cabeza (0 = cabeza, size() - 1 = cola)
+    SDL_Point& segmentAt(size_t i) { return segments[(head + i) & (segments.size() - 1)]; }
+    const SDL_Point& segmentAt(size_t i) const { return segments[(head + i) & (segments.size() - 1)]; }
+    Direction& directionAt(size_t i) { return directions[(head + i) & (directions.size() - 1)]; }
+    Direction directionAt(size_t i) const { return directions[(head + i) & (directions.size() - 1)]; }
+
+    // Añadir una cabeza nueva delante de la actual
+    void pushHead(SDL_Point position, Direction dir) {
+        if (length == segments.size()) {
+            reserve(segments.empty() ? 16 : segments.size() * 2);
+        }
+        head = (head - 1) & (segments.size() - 1);
+        segments[head] = position;
+        directions[head] = dir;
+        ++length;
+    }
+
+    // Descartar el último segmento de la cola
+    void popTail() {
+        if (length > 0) --length;
+    }
+
+    // Duplicar la capacidad (siempre potencia de dos) dejando los segmentos en orden cabeza-cola
+    void reserve(size_t capacity) {
+        std::vector<SDL_Point> newSegments(capacity);
+        std::vector<Direction> newDirections(capacity);
+        for (size_t i = 0; i < length; ++i) {
+            newSegments[i] = segmentAt(i);
+            newDirections[i] = directionAt(i);
+        }
+        segments.swap(newSegments);
+        directions.swap(newDirections);
+        head = 0;
+    }
+};
+
+// Contenido de una celda del tablero (bits combinables)
+enum CellFlags : Uint8 {
+    CELL_EMPTY = 0,
+    CELL_HEAD = 1 << 0,   // Cabeza de la serpiente
+    CELL_BODY = 1 << 1,   // Cuerpo de la serpiente
+    CELL_ROCK = 1 << 2,   // Roca
+    CELL_APPLE = 1 << 3   // Manzana
+};
+
+// Componente con la ocupación del tablero: un byte por tile, actualizado de forma incremental
+// por el movimiento de la serpiente, las rocas y la manzana. Preguntar qué hay en una celda
+// cuesta un solo acceso, sin importar la longitud de la serpiente ni el número de rocas.
+// Además mantiene el conjunto de celdas libres para elegir una al azar en tiempo constante.
+struct Board {
+    std::vector<Uint8> cells;     // Contenido de cada celda
+    std::vector<int> freeCells;   // Índices de las celdas vacías, sin orden
+    std::vector<int> freeSlot;    // Posición de cada celda dentro de freeCells (-1 si está ocupada)
+
+    Board() : cells(GRID_WIDTH * GRID_HEIGHT, CELL_EMPTY), freeCells(GRID_WIDTH * GRID_HEIGHT), freeSlot(GRID_WIDTH * GRID_HEIGHT) {
+        for (int i = 0; i < GRID_WIDTH * GRID_HEIGHT; ++i) {
+            freeCells[i] = i;
+            freeSlot[i] = i;
+        }
+    }
+
+    // Índice de la celda que contiene una posición en píxeles
+    static int indexOf(SDL_Point pos) { return (pos.y / TILE_SIZE) * GRID_WIDTH + pos.x / TILE_SIZE; }
+    // Posición en píxeles de la esquina de una celda
+    static SDL_Point positionOf(int index) { return { (index % GRID_WIDTH) * TILE_SIZE, (index / GRID_WIDTH) * TILE_SIZE }; }
+
+    bool has(SDL_Point pos, Uint8 flags) const { return (cells[indexOf(pos)] & flags) != 0; }
+    bool isFree(SDL_Point pos) const { return cells[indexOf(pos)] == CELL_EMPTY; }
+
+    void set(SDL_Point pos, Uint8 flags) {
+        int index = indexOf(pos);
+        if (cells[index] == CELL_EMPTY && flags != CELL_EMPTY) removeFree(index);
+        cells[index] |= flags;
+    }
+
+    void clear(SDL_Point pos, Uint8 flags) {
+        int index = indexOf(pos);
+        if (cells[index] == CELL_EMPTY) return;
+        cells[index] &= ~flags;
+        if (cells[index] == CELL_EMPTY) addFree(index);
+    }
+
+    // Elegir una celda vacía uniformemente al azar; devuelve false si el tablero está lleno
+    bool randomFreeCell(Rng& rng, SDL_Point& pos) const {
+        if (freeCells.empty()) return false;
+        pos = positionOf(freeCells[rng.below(static_cast<Uint32>(freeCells.size()))]);
+        return true;
+    }
+
+private:
+    // Quitar una celda del conjunto intercambiándola con la última
+    void removeFree(int index) {
+        int slot = freeSlot[index];
+        int last = freeCells.back();
+        freeCells[slot] = last;
+        freeSlot[last] = slot;
+        freeCells.pop_back();
+        freeSlot[index] = -1;
+    }
+
+    void addFree(int index) {
+        freeSlot[index] = static_cast<int>(freeCells.size());
+        freeCells.push_back(index);
+    }
+};
+
+// Componente para la manzana
+struct Apple {
+    SDL_Point position;
+};
+
+// Componente para las rocas
+struct Rock {
+    std::vector<SDL_Point> positions; // Posiciones de las rocas
+    int ticks = 0; // Ticks transcurridos desde el último cambio de posición de las rocas
+    Uint32 version = 0; // Aumenta cada vez que las rocas cambian de posición
+};
+
+// Eventos producidos por un tick de simulación (bits combinables)
+enum TickEvents {
+    TICK_NONE = 0,
+    TICK_APPLE_EATEN = 1 << 0,  // La serpiente comió una manzana
+    TICK_HIT_SELF = 1 << 1,     // La cabeza chocó con el cuerpo
+    TICK_HIT_ROCK = 1 << 2      // La cabeza chocó con una roca
+};
+const int TICK_GAME_OVER = TICK_HIT_SELF | TICK_HIT_ROCK;
+
+// Dirección contraria
+Direction OppositeDirection(Direction direction);
+
+// Posición a la que llega la cabeza al avanzar una celda, dando la vuelta en los bordes
+SDL_Point NextHeadPosition(SDL_Point head, Direction direction, int speed);
+
+// Sistemas de simulación
+void GenerateRock(entt::registry& registry);
+void UpdateRockMovement(entt::registry& registry);
+void UpdateSnakeMovement(entt::registry& registry);
+bool CheckCollisionWithApple(entt::registry& registry, int& appleCounter);
+bool CheckCollisionWithRock(const SnakeBody& snake, const Board& board);
+bool CheckSelfCollision(const SnakeBody& snake, const Board& board);
+
+// Crear las entidades de una partida nueva (tablero, serpiente, manzana y rocas). El
+// generador aleatorio queda como componente del tablero y decide toda la partida.
+// Devuelve la entidad de la serpiente.
+entt::entity CreateGame(entt::registry& registry, const Rng& rng);
+
+// Ejecutar un tick completo de simulación; devuelve una combinación de TickEvents
+int SimulationTick(entt::registry& registry, int& appleCounter);
+
+#endif // GAME_H
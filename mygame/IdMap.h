@@ -0,0 +1,110 @@
+#ifndef IDMAP_H
+#define IDMAP_H
+
+#include <entt/entt.hpp>
+#include <utility>
+#include <vector>
+
+// Tabla hash plana para claves que ya son hashes (entt::id_type de entt::hashed_string):
+// direccionamiento abierto con sondeo lineal sobre un único arreglo, sin nodos ni cadenas.
+// Buscar es mezclar la clave, indexar y comparar enteros.
+template <typename T>
+class IdMap {
+public:
+    T* find(entt::id_type id) {
+        if (entries.empty()) return nullptr;
+        for (size_t i = home(id);; i = (i + 1) & mask()) {
+            if (!entries[i].used) return nullptr;
+            if (entries[i].id == id) return &entries[i].value;
+        }
+    }
+
+    const T* find(entt::id_type id) const {
+        return const_cast<IdMap*>(this)->find(id);
+    }
+
+    // Insertar o sustituir el valor de id
+    T& insert(entt::id_type id, T value) {
+        if (T* existing = find(id)) {
+            *existing = std::move(value);
+            return *existing;
+        }
+
+        // Mantener la ocupación por debajo de la mitad
+        if ((count + 1) * 2 > entries.size()) {
+            rehash(entries.empty() ? 16 : entries.size() * 2);
+        }
+
+        size_t i = home(id);
+        while (entries[i].used) i = (i + 1) & mask();
+        entries[i].id = id;
+        entries[i].used = true;
+        entries[i].value = std::move(value);
+        ++count;
+        return entries[i].value;
+    }
+
+    bool erase(entt::id_type id) {
+        if (entries.empty()) return false;
+
+        size_t i = home(id);
+        while (entries[i].used && entries[i].id != id) i = (i + 1) & mask();
+        if (!entries[i].used) return false;
+
+        // Borrado por desplazamiento: adelantar las entradas siguientes que estaban fuera de su sitio
+        for (size_t j = (i + 1) & mask(); entries[j].used; j = (j + 1) & mask()) {
+            size_t k = home(entries[j].id);
+            bool between = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+            if (!between) {
+                entries[i] = std::move(entries[j]);
+                i = j;
+            }
+        }
+        entries[i].used = false;
+        entries[i].value = T();
+        --count;
+        return true;
+    }
+
+    template <typename F>
+    void forEach(F function) {
+        for (auto& entry : entries) {
+            if (entry.used) function(entry.id, entry.value);
+        }
+    }
+
+    void clear() {
+        entries.clear();
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+
+private:
+    struct Entry {
+        entt::id_type id = 0;
+        bool used = false;
+        T value = T();
+    };
+
+    size_t mask() const { return entries.size() - 1; }
+
+    // Mezclar la clave para repartir bien aunque solo se usen los bits bajos
+    size_t home(entt::id_type id) const {
+        return static_cast<size_t>((id * 0x9E3779B1u) ^ (id >> 16)) & mask();
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<Entry> old = std::move(entries);
+        entries.assign(capacity, Entry());
+        count = 0;
+        for (auto& entry : old) {
+            if (entry.used) insert(entry.id, std::move(entry.value));
+        }
+    }
+
+    std::vector<Entry> entries;  // Capacidad potencia de dos
+    size_t count = 0;
+};
+
+#endif // IDMAP_H
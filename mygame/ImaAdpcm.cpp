@@ -0,0 +1,71 @@
+#include "ImaAdpcm.h"
+
+static const Sint8 INDEX_TABLE[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+static const Sint16 STEP_TABLE[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+// Aplicar un nibble al estado del canal y devolver la muestra resultante
+static inline Sint16 DecodeNibble(Uint8 nibble, int& predictor, int& stepIndex) {
+    int step = STEP_TABLE[stepIndex];
+    int diff = step >> 3;
+    if (nibble & 1) diff += step >> 2;
+    if (nibble & 2) diff += step >> 1;
+    if (nibble & 4) diff += step;
+    predictor += (nibble & 8) ? -diff : diff;
+    if (predictor > 32767) predictor = 32767;
+    if (predictor < -32768) predictor = -32768;
+
+    stepIndex += INDEX_TABLE[nibble];
+    if (stepIndex < 0) stepIndex = 0;
+    if (stepIndex > 88) stepIndex = 88;
+    return static_cast<Sint16>(predictor);
+}
+
+bool IsImaAdpcm(const WavInfo& info) {
+    // Cabecera de 4 bytes por canal y datos en grupos de 4 bytes por canal
+    int headerBytes = 4 * info.channels;
+    return info.encoding == WAV_FORMAT_IMA_ADPCM && info.bitsPerSample == 4 && info.channels > 0 &&
+           info.blockAlign > headerBytes && (info.blockAlign - headerBytes) % headerBytes == 0;
+}
+
+int ImaAdpcmFramesPerBlock(int blockAlign, int channels) {
+    return (blockAlign - 4 * channels) * 2 / channels + 1;
+}
+
+int DecodeImaAdpcmBlock(const Uint8* block, int bytes, int channels, Sint16* out) {
+    const int headerBytes = 4 * channels;
+    if (bytes < headerBytes) return 0;
+
+    // Los datos van en grupos de 4 bytes (8 muestras) por canal, un canal detrás de otro
+    const int groups = (bytes - headerBytes) / headerBytes;
+    const int frames = 1 + groups * 8;
+
+    for (int channel = 0; channel < channels; ++channel) {
+        const Uint8* header = block + channel * 4;
+        int predictor = static_cast<Sint16>(header[0] | (header[1] << 8));
+        int stepIndex = header[2] > 88 ? 88 : header[2];
+
+        // La primera muestra es el propio predictor
+        Sint16* sample = out + channel;
+        *sample = static_cast<Sint16>(predictor);
+        sample += channels;
+
+        const Uint8* data = block + headerBytes + channel * 4;
+        for (int group = 0; group < groups; ++group, data += headerBytes) {
+            for (int i = 0; i < 4; ++i) {
+                // Nibble bajo primero
+                *sample = DecodeNibble(data[i] & 0x0F, predictor, stepIndex);
+                sample += channels;
+                *sample = DecodeNibble(data[i] >> 4, predictor, stepIndex);
+                sample += channels;
+            }
+        }
+    }
+    return frames;
+}
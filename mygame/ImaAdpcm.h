@@ -0,0 +1,25 @@
+#ifndef IMAADPCM_H
+#define IMAADPCM_H
+
+#include <SDL.h>
+#include "WavFile.h"
+
+// Decodificador IMA-ADPCM (etiqueta 0x0011 de WAV): 4 bits por muestra, una cuarta parte del
+// tamaño de PCM de 16 bits. Cada bloque empieza con el predictor y el índice de paso de cada
+// canal y se decodifica de forma independiente, así que se puede leer y decodificar por trozos.
+// Es solo sumas, desplazamientos y dos tablas, sin reservar memoria: rápido para el hilo de la
+// música o incluso para el callback de audio.
+
+const Uint16 WAV_FORMAT_IMA_ADPCM = 0x0011;
+
+// El WAV es IMA-ADPCM con una disposición de bloques válida
+bool IsImaAdpcm(const WavInfo& info);
+
+// Frames que contiene un bloque completo de blockAlign bytes
+int ImaAdpcmFramesPerBlock(int blockAlign, int channels);
+
+// Decodificar un bloque (o el último, incompleto, de bytes < blockAlign) a PCM de 16 bits
+// intercalado en out. Devuelve los frames escritos.
+int DecodeImaAdpcmBlock(const Uint8* block, int bytes, int channels, Sint16* out);
+
+#endif // IMAADPCM_H
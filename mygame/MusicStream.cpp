@@ -0,0 +1,180 @@
+#include "MusicStream.h"
+#include "AssetPack.h"
+#include "ImaAdpcm.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+bool MusicStream::open(const char* filePath, const SDL_AudioSpec& deviceSpec) {
+    close();
+
+    file = AssetPack::Open(filePath);
+    if (!file) {
+        std::cerr << "Error al abrir la música " << filePath << ": " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    SDL_AudioFormat sourceFormat = 0;
+    if (ReadWavHeader(file, wav)) {
+        adpcm = IsImaAdpcm(wav);
+        sourceFormat = adpcm ? AUDIO_S16SYS : WavSampleFormat(wav);
+    }
+    if (sourceFormat == 0 || wav.dataSize == 0) {
+        std::cerr << "Error al leer la música " << filePath << ": formato WAV no soportado" << std::endl;
+        close();
+        return false;
+    }
+
+    converter = SDL_NewAudioStream(sourceFormat, static_cast<Uint8>(wav.channels), static_cast<int>(wav.freq),
+                                   deviceSpec.format, deviceSpec.channels, deviceSpec.freq);
+    if (!converter) {
+        std::cerr << "Error al preparar la conversión de " << filePath << ": " << SDL_GetError() << std::endl;
+        close();
+        return false;
+    }
+
+    // Toda la memoria se reserva aquí; después solo se reutiliza
+    channels = deviceSpec.channels;
+    dataRead = 0;
+    readBuffer.resize(std::max<size_t>(wav.blockAlign, READ_BYTES - READ_BYTES % wav.blockAlign));
+    if (adpcm) {
+        size_t blocks = readBuffer.size() / wav.blockAlign;
+        decodeBuffer.resize(blocks * ImaAdpcmFramesPerBlock(wav.blockAlign, wav.channels) * wav.channels);
+    }
+    for (int i = 0; i < 2; ++i) {
+        chunks[i].assign(static_cast<size_t>(CHUNK_FRAMES) * channels, 0);
+        ready[i].store(false, std::memory_order_relaxed);
+    }
+    fillIndex = 0;
+    playIndex = 0;
+    playPosition = 0;
+
+    quit.store(false, std::memory_order_relaxed);
+    freeChunks = SDL_CreateSemaphore(2);
+    thread = SDL_CreateThread(decodeThread, "music", this);
+    if (!freeChunks || !thread) {
+        std::cerr << "Error al crear el hilo de la música: " << SDL_GetError() << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MusicStream::close() {
+    if (thread) {
+        quit.store(true, std::memory_order_release);
+        SDL_SemPost(freeChunks);
+        SDL_WaitThread(thread, NULL);
+        thread = nullptr;
+    }
+    if (freeChunks) {
+        SDL_DestroySemaphore(freeChunks);
+        freeChunks = nullptr;
+    }
+    if (converter) {
+        SDL_FreeAudioStream(converter);
+        converter = nullptr;
+    }
+    if (file) {
+        SDL_RWclose(file);
+        file = nullptr;
+    }
+}
+
+int MusicStream::read(Sint16* out, int frames) {
+    int copied = 0;
+    while (copied < frames) {
+        if (!ready[playIndex].load(std::memory_order_acquire)) {
+            break;  // El hilo no ha llegado a tiempo: el resto del bloque queda en silencio
+        }
+
+        int count = std::min(CHUNK_FRAMES - playPosition, frames - copied);
+        std::memcpy(out + static_cast<size_t>(copied) * channels,
+                    chunks[playIndex].data() + static_cast<size_t>(playPosition) * channels,
+                    static_cast<size_t>(count) * channels * sizeof(Sint16));
+        copied += count;
+        playPosition += count;
+
+        // Buffer agotado: devolverlo al hilo y pasar al otro
+        if (playPosition == CHUNK_FRAMES) {
+            ready[playIndex].store(false, std::memory_order_release);
+            SDL_SemPost(freeChunks);
+            playIndex ^= 1;
+            playPosition = 0;
+        }
+    }
+    return copied;
+}
+
+int SDLCALL MusicStream::decodeThread(void* userdata) {
+    auto* music = static_cast<MusicStream*>(userdata);
+    Profiler::SetThreadName("music");
+
+    while (true) {
+        SDL_SemWait(music->freeChunks);
+        if (music->quit.load(std::memory_order_acquire)) break;
+
+        PROFILE_SCOPE("MusicStream::fillChunk");
+        music->fillChunk(music->chunks[music->fillIndex]);
+        music->ready[music->fillIndex].store(true, std::memory_order_release);
+        music->fillIndex ^= 1;
+    }
+    return 0;
+}
+
+void MusicStream::fillChunk(std::vector<Sint16>& chunk) {
+    const int chunkBytes = static_cast<int>(chunk.size() * sizeof(Sint16));
+
+    // Alimentar la conversión hasta tener un buffer completo
+    while (SDL_AudioStreamAvailable(converter) < chunkBytes) {
+        if (!feedStream()) {
+            break;
+        }
+    }
+
+    int got = SDL_AudioStreamGet(converter, chunk.data(), chunkBytes);
+    if (got < 0) got = 0;
+    // Si la lectura falla se rellena con silencio en vez de dejar de avanzar
+    std::memset(reinterpret_cast<Uint8*>(chunk.data()) + got, 0, static_cast<size_t>(chunkBytes - got));
+}
+
+bool MusicStream::feedStream() {
+    // Al terminar "data" volver al principio para el bucle
+    if (dataRead >= wav.dataSize) {
+        if (SDL_RWseek(file, wav.dataOffset, RW_SEEK_SET) < 0) return false;
+        dataRead = 0;
+    }
+
+    Uint32 wanted = std::min<Uint32>(static_cast<Uint32>(readBuffer.size()), wav.dataSize - dataRead);
+    size_t bytes = SDL_RWread(file, readBuffer.data(), 1, wanted);
+    if (bytes < wanted) {
+        // Archivo truncado (o error de lectura): hay menos datos de los que anuncia la cabecera.
+        // Se toma como el final de "data" y se vuelve al principio, así la música sigue en bucle.
+        bool atStart = dataRead == 0;
+        if (SDL_RWseek(file, wav.dataOffset, RW_SEEK_SET) < 0) return false;
+        dataRead = 0;
+        if (bytes == 0) return !atStart;  // Si ni desde el principio hay datos, silencio
+    } else {
+        dataRead += static_cast<Uint32>(bytes);
+    }
+
+    if (adpcm) {
+        // Decodificar cada bloque; solo el último de "data" puede estar incompleto
+        size_t frames = 0;
+        for (size_t offset = 0; offset < bytes; offset += wav.blockAlign) {
+            int blockBytes = static_cast<int>(std::min<size_t>(wav.blockAlign, bytes - offset));
+            frames += DecodeImaAdpcmBlock(readBuffer.data() + offset, blockBytes, wav.channels,
+                                          decodeBuffer.data() + frames * wav.channels);
+        }
+        if (frames == 0) return false;
+        int pcmBytes = static_cast<int>(frames * wav.channels * sizeof(Sint16));
+        return SDL_AudioStreamPut(converter, decodeBuffer.data(), pcmBytes) == 0;
+    }
+
+    // SDL_AudioStream solo acepta frames completos
+    bytes -= bytes % wav.blockAlign;
+    if (bytes == 0) return false;
+
+    return SDL_AudioStreamPut(converter, readBuffer.data(), static_cast<int>(bytes)) == 0;
+}
@@ -0,0 +1,58 @@
+#ifndef MUSICSTREAM_H
+#define MUSICSTREAM_H
+
+#include <SDL.h>
+#include "WavFile.h"
+#include <atomic>
+#include <vector>
+
+// Música en streaming: un hilo lee el WAV por trozos de tamaño fijo, los convierte al formato
+// del dispositivo con SDL_AudioStream y llena un doble buffer. El callback de audio consume un
+// buffer mientras el hilo llena el otro, así que la memoria no depende de la duración de la pista
+// y la música empieza a sonar en cuanto está listo el primer trozo. Al llegar al final del bloque
+// "data" se vuelve al principio sin vaciar la conversión, de modo que el bucle no tiene cortes.
+// Acepta PCM y IMA-ADPCM; este último se decodifica en el hilo, bloque a bloque.
+class MusicStream {
+public:
+    static const int CHUNK_FRAMES = 8192;   // Frames del dispositivo por buffer
+    static const int READ_BYTES = 16384;    // Bytes leídos del archivo en cada lectura
+
+    MusicStream() = default;
+    ~MusicStream() { close(); }
+    MusicStream(const MusicStream&) = delete;
+    MusicStream& operator=(const MusicStream&) = delete;
+
+    // Abrir el WAV y arrancar el hilo de lectura
+    bool open(const char* filePath, const SDL_AudioSpec& deviceSpec);
+    void close();
+
+    // Copiar hasta frames frames en out. Se llama desde el callback de audio: no bloquea ni
+    // reserva memoria. Devuelve menos frames si el hilo todavía no ha llenado el buffer siguiente.
+    int read(Sint16* out, int frames);
+
+private:
+    static int SDLCALL decodeThread(void* userdata);
+    void fillChunk(std::vector<Sint16>& chunk);
+    bool feedStream();
+
+    SDL_RWops* file = nullptr;
+    WavInfo wav;
+    Uint32 dataRead = 0;                      // Bytes de "data" leídos en la vuelta actual
+    SDL_AudioStream* converter = nullptr;
+    int channels = 0;
+    std::vector<Uint8> readBuffer;
+    bool adpcm = false;
+    std::vector<Sint16> decodeBuffer;         // PCM de los bloques ADPCM de una lectura
+
+    SDL_Thread* thread = nullptr;
+    SDL_sem* freeChunks = nullptr;            // Buffers vacíos que el hilo puede llenar
+    std::atomic<bool> quit{false};
+
+    std::vector<Sint16> chunks[2];
+    std::atomic<bool> ready[2];               // El buffer está lleno y listo para el callback
+    int fillIndex = 0;                        // Buffer que llena el hilo
+    int playIndex = 0;                        // Buffer que consume el callback
+    int playPosition = 0;                     // Frame siguiente dentro de chunks[playIndex]
+};
+
+#endif // MUSICSTREAM_H
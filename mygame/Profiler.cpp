@@ -0,0 +1,185 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#ifdef MYGAME_PROFILER
+
+// Intervalo del anillo. Los campos son atómicos para poder leerlos desde otro hilo mientras el
+// dueño escribe; con orden relajado cuestan lo mismo que una escritura normal.
+struct ProfileEvent {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<Uint64> start{0};
+    std::atomic<Uint64> end{0};
+};
+
+// Anillo de un hilo. No se liberan nunca: los intervalos de un hilo terminado siguen en la traza.
+struct ProfileThreadBuffer {
+    int threadId = 0;
+    std::string name;                 // Protegido por profileBuffersMutex
+    std::atomic<Uint64> written{0};   // Intervalos escritos desde el principio
+    std::unique_ptr<ProfileEvent[]> events{new ProfileEvent[Profiler::RING_SIZE]};
+};
+
+static std::mutex profileBuffersMutex;
+static std::vector<std::unique_ptr<ProfileThreadBuffer>> profileBuffers;
+
+// Anillo del hilo actual; el cerrojo solo se toma la primera vez que mide cada hilo
+static ProfileThreadBuffer* CurrentThreadBuffer() {
+    thread_local ProfileThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(profileBuffersMutex);
+        profileBuffers.emplace_back(new ProfileThreadBuffer());
+        buffer = profileBuffers.back().get();
+        buffer->threadId = static_cast<int>(profileBuffers.size());
+        buffer->name = "hilo " + std::to_string(buffer->threadId);
+    }
+    return buffer;
+}
+
+// Copia de un intervalo para escribir la traza
+struct ProfileSample {
+    const char* name;
+    Uint64 start;
+    Uint64 end;
+};
+
+// Copiar los intervalos de un anillo que otro hilo puede estar escribiendo. Los que el dueño haya
+// podido pisar durante la copia (incluido el que esté escribiendo) se descartan. Funciona como el
+// lector de un seqlock: si la copia vio algún campo de un intervalo nuevo, la barrera de adquisición
+// garantiza que el segundo written ve ya el índice de ese intervalo (ver Record).
+static void CopyEvents(const ProfileThreadBuffer& buffer, std::vector<ProfileSample>& samples) {
+    const Uint64 ring = Profiler::RING_SIZE;
+    Uint64 written = buffer.written.load(std::memory_order_acquire);
+    Uint64 first = written > ring ? written - ring : 0;
+
+    size_t copyStart = samples.size();
+    for (Uint64 i = first; i < written; ++i) {
+        const ProfileEvent& event = buffer.events[i & (ring - 1)];
+        samples.push_back({ event.name.load(std::memory_order_relaxed), event.start.load(std::memory_order_relaxed),
+                            event.end.load(std::memory_order_relaxed) });
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    Uint64 after = buffer.written.load(std::memory_order_relaxed);
+    Uint64 valid = after + 1 > ring ? after + 1 - ring : 0;
+    if (valid > first) {
+        size_t overwritten = static_cast<size_t>(std::min(valid, written) - first);
+        samples.erase(samples.begin() + copyStart, samples.begin() + copyStart + overwritten);
+    }
+}
+
+// Escribir una cadena JSON; los nombres son literales del código, pero por si acaso
+static void WriteJsonString(std::ofstream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out << '\\';
+        if (static_cast<unsigned char>(*c) >= 0x20) out << *c;
+    }
+    out << '"';
+}
+
+Uint64 Profiler::Now() {
+    return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::SetThreadName(const char* name) {
+    ProfileThreadBuffer* buffer = CurrentThreadBuffer();
+    std::lock_guard<std::mutex> lock(profileBuffersMutex);
+    buffer->name = name;
+}
+
+void Profiler::Record(const char* name, Uint64 start, Uint64 end) {
+    ProfileThreadBuffer* buffer = CurrentThreadBuffer();
+    Uint64 index = buffer->written.load(std::memory_order_relaxed);
+    ProfileEvent& event = buffer->events[index & (RING_SIZE - 1)];
+    // Como el escritor de un seqlock: la barrera impide que las escrituras de los campos se vean
+    // antes que el written anterior, así CopyEvents solo puede encontrar a medias el intervalo
+    // index. En x86 no genera ninguna instrucción.
+    std::atomic_thread_fence(std::memory_order_release);
+    event.name.store(name, std::memory_order_relaxed);
+    event.start.store(start, std::memory_order_relaxed);
+    event.end.store(end, std::memory_order_relaxed);
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+bool Profiler::WriteChromeTrace(const char* path) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    // Copiar los anillos y sus nombres con el cerrojo, y escribir el archivo sin él
+    std::vector<std::pair<int, std::string>> threads;
+    std::vector<std::vector<ProfileSample>> samples;
+    {
+        std::lock_guard<std::mutex> lock(profileBuffersMutex);
+        for (const auto& buffer : profileBuffers) {
+            threads.emplace_back(buffer->threadId, buffer->name);
+            samples.emplace_back();
+            CopyEvents(*buffer, samples.back());
+        }
+    }
+
+    // Los tiempos se escriben en microsegundos desde el primer intervalo guardado
+    Uint64 origin = ~0ull;
+    for (const auto& thread : samples) {
+        for (const auto& sample : thread) origin = std::min(origin, sample.start);
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (size_t t = 0; t < threads.size(); ++t) {
+        out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threads[t].first
+            << ",\"args\":{\"name\":";
+        WriteJsonString(out, threads[t].second.c_str());
+        out << "}}";
+        first = false;
+
+        for (const auto& sample : samples[t]) {
+            out << ",\n{\"name\":";
+            WriteJsonString(out, sample.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << threads[t].first << ",\"ts\":" << (sample.start - origin) / 1000.0
+                << ",\"dur\":" << (sample.end - sample.start) / 1000.0 << "}";
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+void Profiler::CollectTotals(Uint64 since, std::vector<ProfileTotal>& totals) {
+    totals.clear();
+    ProfileThreadBuffer* buffer = CurrentThreadBuffer();
+    Uint64 written = buffer->written.load(std::memory_order_relaxed);
+    Uint64 first = written > static_cast<Uint64>(RING_SIZE) ? written - RING_SIZE : 0;
+
+    // Los intervalos se guardan al terminar, así que sus finales van en orden: se recorre hacia
+    // atrás hasta el primero que terminó antes de since
+    for (Uint64 i = written; i > first; --i) {
+        const ProfileEvent& event = buffer->events[(i - 1) & (RING_SIZE - 1)];
+        if (event.end.load(std::memory_order_relaxed) < since) break;
+        if (event.start.load(std::memory_order_relaxed) < since) continue;
+
+        const char* name = event.name.load(std::memory_order_relaxed);
+        auto total = std::find_if(totals.begin(), totals.end(), [name](const ProfileTotal& t) { return t.name == name; });
+        if (total == totals.end()) {
+            totals.push_back({ name, 0, 0 });
+            total = totals.end() - 1;
+        }
+        total->nanoseconds += event.end.load(std::memory_order_relaxed) - event.start.load(std::memory_order_relaxed);
+        ++total->calls;
+    }
+}
+
+#else
+
+Uint64 Profiler::Now() { return 0; }
+void Profiler::SetThreadName(const char*) {}
+void Profiler::Record(const char*, Uint64, Uint64) {}
+bool Profiler::WriteChromeTrace(const char*) { return false; }
+void Profiler::CollectTotals(Uint64, std::vector<ProfileTotal>& totals) { totals.clear(); }
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Perfilador por secciones: PROFILE_SCOPE("Nombre") mide desde ese punto hasta el final del
+// bloque y guarda el intervalo en un anillo propio de cada hilo, sin cerrojos (solo escribe el
+// hilo dueño). Cuando el anillo se llena se pisan los intervalos más antiguos.
+//
+// Se compila con la opción MYGAME_PROFILER de CMake; sin ella PROFILE_SCOPE no genera código y
+// las funciones de Profiler no devuelven nada. No usa SDL, así que sirve también en mygame_core.
+#include <SDL_stdinc.h>
+#include <vector>
+
+// Tiempo acumulado de una sección
+struct ProfileTotal {
+    const char* name = nullptr;
+    Uint64 nanoseconds = 0;
+    Uint32 calls = 0;
+};
+
+class Profiler {
+public:
+    static const int RING_SIZE = 1 << 16;  // Intervalos guardados por hilo (potencia de dos)
+
+#ifdef MYGAME_PROFILER
+    static const bool ENABLED = true;
+#else
+    static const bool ENABLED = false;
+#endif
+
+    // Reloj del perfilador, en nanosegundos
+    static Uint64 Now();
+
+    // Nombre del hilo actual en la traza (por defecto "hilo N")
+    static void SetThreadName(const char* name);
+
+    // Guardar un intervalo en el anillo del hilo actual. name debe ser una cadena literal.
+    static void Record(const char* name, Uint64 start, Uint64 end);
+
+    // Escribir los intervalos de todos los hilos en formato de Chrome (chrome://tracing o
+    // ui.perfetto.dev). Se puede llamar mientras los demás hilos siguen escribiendo.
+    static bool WriteChromeTrace(const char* path);
+
+    // Sumar por sección los intervalos del hilo actual que empiezan en since o después (en
+    // nanosegundos de Now()), sin ningún orden concreto
+    static void CollectTotals(Uint64 since, std::vector<ProfileTotal>& totals);
+};
+
+#ifdef MYGAME_PROFILER
+
+// Mide la vida del objeto y la guarda al destruirse
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name), start(Profiler::Now()) {}
+    ~ProfileScope() { Profiler::Record(name, start, Profiler::Now()); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    Uint64 start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+
+#endif
+
+#endif // PROFILER_H
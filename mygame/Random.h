@@ -0,0 +1,81 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <SDL_rect.h>
+
+// Generador pseudoaleatorio xoshiro128** con semilla propia. Cada partida tiene el suyo, así
+// que varias simulaciones en paralelo no comparten estado y cualquier partida se puede
+// reproducir a partir de su semilla.
+class Rng {
+public:
+    explicit Rng(Uint64 seed = 1) { reseed(seed); }
+
+    // Reiniciar el estado a partir de una semilla de 64 bits (expandida con splitmix64)
+    void reseed(Uint64 seed) {
+        for (int i = 0; i < 4; i += 2) {
+            Uint64 z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            z ^= z >> 31;
+            state[i] = static_cast<Uint32>(z);
+            state[i + 1] = static_cast<Uint32>(z >> 32);
+        }
+    }
+
+    // Siguiente número de 32 bits
+    Uint32 next() {
+        const Uint32 result = rotl(state[1] * 5, 7) * 9;
+        const Uint32 t = state[1] << 9;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 11);
+
+        return result;
+    }
+
+    // Número uniforme en [0, bound) sin el sesgo de usar %, con el método de Lemire
+    Uint32 below(Uint32 bound) {
+        Uint64 m = static_cast<Uint64>(next()) * bound;
+        Uint32 low = static_cast<Uint32>(m);
+        if (low < bound) {
+            const Uint32 threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                m = static_cast<Uint64>(next()) * bound;
+                low = static_cast<Uint32>(m);
+            }
+        }
+        return static_cast<Uint32>(m >> 32);
+    }
+
+    // Avanzar 2^64 pasos: copias sucesivas separadas por jump() dan secuencias independientes
+    void jump() {
+        static const Uint32 JUMP[] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+        Uint32 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (Uint32 word : JUMP) {
+            for (int b = 0; b < 32; ++b) {
+                if (word & (1u << b)) {
+                    s0 ^= state[0];
+                    s1 ^= state[1];
+                    s2 ^= state[2];
+                    s3 ^= state[3];
+                }
+                next();
+            }
+        }
+        state[0] = s0;
+        state[1] = s1;
+        state[2] = s2;
+        state[3] = s3;
+    }
+
+private:
+    static Uint32 rotl(Uint32 x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    Uint32 state[4];
+};
+
+#endif // RANDOM_H
@@ -0,0 +1,205 @@
+#include "RenderSystems.h"
+#include "Profiler.h"
+#include <cmath>
+
+// Sistema de renderizado para la roca
+void RenderRockSystem(entt::registry& registry, SDL_Renderer* renderer) {
+    PROFILE_SCOPE("RenderRockSystem");
+    auto view = registry.view<Rock, Sprite>();
+
+    for (auto entity : view) {
+        auto& rock = view.get<Rock>(entity);
+        auto& sprite = view.get<Sprite>(entity);
+
+        for (auto& pos : rock.positions) {
+            SDL_Rect dstRect = { pos.x, pos.y, TILE_SIZE, TILE_SIZE };
+            SDL_RenderCopy(renderer, sprite.texture, &sprite.srcRect, &dstRect);
+        }
+    }
+}
+
+// Posición del segmento i interpolada entre el tick anterior y el actual (alpha en [0, 1])
+SDL_Point InterpolateSegment(const SnakeBody& snake, size_t i, float alpha) {
+    const SDL_Point& current = snake.segmentAt(i);
+    // Cada segmento ocupa en este tick la celda en la que estaba el siguiente en el tick anterior
+    const SDL_Point& previous = i + 1 < snake.size() ? snake.segmentAt(i + 1) : snake.prevTail;
+
+    // Al cruzar un borde de la pantalla no se interpola, el segmento salta al otro lado
+    if (std::abs(current.x - previous.x) > TILE_SIZE || std::abs(current.y - previous.y) > TILE_SIZE) {
+        return current;
+    }
+
+    return { previous.x + static_cast<int>((current.x - previous.x) * alpha),
+             previous.y + static_cast<int>((current.y - previous.y) * alpha) };
+}
+
+// Añadir a la malla un tile en pos con el sprite srcRect girado quarterTurns cuartos de vuelta
+// en sentido horario. El giro se aplica rotando las coordenadas de textura de las esquinas.
+static void AppendSpriteQuad(SnakeMesh& mesh, SDL_Point pos, const SDL_Rect& srcRect, int quarterTurns, float textureWidth, float textureHeight) {
+    const SDL_Color white = { 255, 255, 255, 255 };
+    float u0 = srcRect.x / textureWidth;
+    float v0 = srcRect.y / textureHeight;
+    float u1 = (srcRect.x + srcRect.w) / textureWidth;
+    float v1 = (srcRect.y + srcRect.h) / textureHeight;
+
+    // Esquinas en sentido horario empezando por la superior izquierda
+    const SDL_FPoint corners[4] = {
+        { static_cast<float>(pos.x), static_cast<float>(pos.y) },
+        { static_cast<float>(pos.x + TILE_SIZE), static_cast<float>(pos.y) },
+        { static_cast<float>(pos.x + TILE_SIZE), static_cast<float>(pos.y + TILE_SIZE) },
+        { static_cast<float>(pos.x), static_cast<float>(pos.y + TILE_SIZE) }
+    };
+    const SDL_FPoint uvs[4] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+
+    for (int corner = 0; corner < 4; ++corner) {
+        mesh.vertices.push_back({ corners[corner], white, uvs[(corner - quarterTurns + 4) & 3] });
+    }
+}
+
+// Sistema de renderizado para la serpiente: toda la serpiente se envía en una sola llamada
+// a SDL_RenderGeometry, así que el número de llamadas no depende de su longitud
+void RenderSnakeSystem(entt::registry& registry, SDL_Renderer* renderer, float alpha) {
+    PROFILE_SCOPE("RenderSnakeSystem");
+    auto view = registry.view<SnakeSegment, SnakeBody, SnakeMesh>();
+
+    for (auto entity : view) {
+        auto& segment = view.get<SnakeSegment>(entity);
+        auto& snake = view.get<SnakeBody>(entity);
+        auto& mesh = view.get<SnakeMesh>(entity);
+
+        int textureWidth = 0;
+        int textureHeight = 0;
+        SDL_QueryTexture(segment.texture, NULL, NULL, &textureWidth, &textureHeight);
+
+        // Los índices siguen el mismo patrón para todos los tiles; solo se añaden los que falten
+        size_t quads = snake.size();
+        for (size_t quad = mesh.indices.size() / 6; quad < quads; ++quad) {
+            int first = static_cast<int>(quad * 4);
+            int pattern[6] = { first, first + 1, first + 2, first, first + 2, first + 3 };
+            mesh.indices.insert(mesh.indices.end(), pattern, pattern + 6);
+        }
+
+        // Construir la cabeza y los segmentos del cuerpo
+        mesh.vertices.clear();
+        for (size_t i = 0; i < quads; ++i) {
+            SDL_Point pos = InterpolateSegment(snake, i, alpha);
+            int quarterTurns = 0;
+
+            if (i == 0) {
+                // La cabeza gira según la dirección
+                switch (snake.direction) {
+                    case UP:
+                        quarterTurns = 2;
+                        break;
+                    case DOWN:
+                        quarterTurns = 0;
+                        break;
+                    case LEFT:
+                        quarterTurns = 1;
+                        break;
+                    case RIGHT:
+                        quarterTurns = 3;
+                        break;
+                }
+                SDL_Rect headRect = { segment.srcRect.x, segment.srcRect.y, 8, 8 };  // Sprite de la cabeza en la posición 1
+                AppendSpriteQuad(mesh, pos, headRect, quarterTurns, static_cast<float>(textureWidth), static_cast<float>(textureHeight));
+            } else {
+                SDL_Rect bodyRect = { segment.srcRect.x + 8, segment.srcRect.y, 8, 8 };  // Usar el sprite del cuerpo (posición 2)
+
+                // Aplicar la rotación solo si el cuerpo se mueve en dirección horizontal
+                switch (snake.directionAt(i)) {
+                    case UP:
+                    case DOWN:
+                        quarterTurns = 0;  // No rotar para el movimiento vertical
+                        break;
+                    case LEFT:
+                    case RIGHT:
+                        quarterTurns = 1;  // Rotar 90 grados para el movimiento horizontal
+                        break;
+                }
+                AppendSpriteQuad(mesh, pos, bodyRect, quarterTurns, static_cast<float>(textureWidth), static_cast<float>(textureHeight));
+            }
+        }
+
+        SDL_RenderGeometry(renderer, segment.texture, mesh.vertices.data(), static_cast<int>(mesh.vertices.size()),
+                           mesh.indices.data(), static_cast<int>(quads * 6));
+    }
+}
+
+// Sistema de renderizado para la manzana
+void RenderAppleSystem(entt::registry& registry, SDL_Renderer* renderer) {
+    PROFILE_SCOPE("RenderAppleSystem");
+    auto view = registry.view<Apple, Sprite>();
+
+    for (auto entity : view) {
+        auto& apple = view.get<Apple>(entity);
+        auto& sprite = view.get<Sprite>(entity);
+
+        SDL_Rect dstRect = { apple.position.x, apple.position.y, TILE_SIZE, TILE_SIZE };
+        SDL_RenderCopy(renderer, sprite.texture, &sprite.srcRect, &dstRect);
+    }
+}
+
+// Sistema para renderizar el fondo
+void RenderBackgroundSystem(entt::registry& registry, SDL_Renderer* renderer) {
+    PROFILE_SCOPE("RenderBackgroundSystem");
+    auto view = registry.view<BackgroundTexture>();
+
+    for (auto entity : view) {
+        auto& bg = view.get<BackgroundTexture>(entity);
+        SDL_Rect dstRect = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+
+        // Hasta que la textura esté lista se dibuja un color liso
+        Texture* texture = TextureManager::GetTexture(bg.texture.get());
+        if (!texture) {
+            SDL_SetRenderDrawColor(renderer, BACKGROUND_PLACEHOLDER.r, BACKGROUND_PLACEHOLDER.g, BACKGROUND_PLACEHOLDER.b, BACKGROUND_PLACEHOLDER.a);
+            SDL_RenderFillRect(renderer, &dstRect);
+            continue;
+        }
+        SDL_RenderCopy(renderer, texture->sdlTexture, NULL, &dstRect);
+    }
+}
+
+// Sistema de renderizado de la capa estática: compone fondo y rocas en una textura cuando
+// cambian y después la copia a pantalla, así cada frame cuesta una sola copia completa
+void RenderStaticLayerSystem(entt::registry& registry, SDL_Renderer* renderer) {
+    PROFILE_SCOPE("RenderStaticLayerSystem");
+    auto view = registry.view<StaticLayer>();
+
+    for (auto entity : view) {
+        auto& layer = view.get<StaticLayer>(entity);
+
+        // Sin texturas de destino se dibuja todo directamente, como antes
+        if (!layer.texture) {
+            RenderBackgroundSystem(registry, renderer);
+            RenderRockSystem(registry, renderer);
+            continue;
+        }
+
+        Uint32 rockVersion = 0;
+        for (auto rockEntity : registry.view<Rock>()) {
+            rockVersion += registry.get<Rock>(rockEntity).version;
+        }
+
+        // Al terminar de cargarse el fondo hay que sustituir el color provisional
+        bool backgroundReady = true;
+        for (auto bgEntity : registry.view<BackgroundTexture>()) {
+            backgroundReady = backgroundReady && registry.get<BackgroundTexture>(bgEntity).texture.ready();
+        }
+
+        if (layer.dirty || layer.rockVersion != rockVersion || layer.backgroundReady != backgroundReady) {
+            SDL_SetRenderTarget(renderer, layer.texture);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+            RenderBackgroundSystem(registry, renderer);
+            RenderRockSystem(registry, renderer);
+            SDL_SetRenderTarget(renderer, NULL);
+
+            layer.rockVersion = rockVersion;
+            layer.backgroundReady = backgroundReady;
+            layer.dirty = false;
+        }
+
+        SDL_RenderCopy(renderer, layer.texture, NULL, NULL);
+    }
+}
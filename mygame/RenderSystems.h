@@ -0,0 +1,56 @@
+#ifndef RENDERSYSTEMS_H
+#define RENDERSYSTEMS_H
+
+// Componentes de dibujo y sistemas de renderizado del juego. Están fuera de main.cpp para que
+// mygame_bench pueda medirlos con el renderer por software.
+#include <SDL.h>
+#include <entt/entt.hpp>
+#include "Game.h"
+#include "TextureManager.h"
+#include <vector>
+
+const SDL_Color BACKGROUND_PLACEHOLDER = { 34, 85, 34, 255 };  // Color liso mientras se carga el fondo
+
+// Componente para almacenar la textura del fondo; se carga en segundo plano
+struct BackgroundTexture {
+    TextureFuture texture;
+};
+
+// Componente con la capa estática (fondo y rocas) ya compuesta en una textura de destino.
+// Solo se vuelve a dibujar cuando las rocas cambian de lugar.
+struct StaticLayer {
+    SDL_Texture* texture = nullptr;  // Textura de destino; nula si el renderer no las admite
+    Uint32 rockVersion = 0;          // Versión de las rocas dibujada en la capa
+    bool backgroundReady = false;    // La capa se compuso con el fondo ya cargado
+    bool dirty = true;               // La capa debe redibujarse
+};
+
+// Componente para los segmentos de la serpiente
+struct SnakeSegment {
+    SDL_Texture* texture;
+    SDL_Rect srcRect;  // Hoja de sprites de la serpiente dentro de la textura (cabeza y cuerpo de 8x8)
+};
+
+// Componente con la malla de la serpiente; se reutiliza entre frames para no reservar memoria
+struct SnakeMesh {
+    std::vector<SDL_Vertex> vertices;  // Cuatro vértices por tile
+    std::vector<int> indices;          // Seis índices (dos triángulos) por tile
+};
+
+// Componente con el sprite de las entidades que se dibujan con una sola imagen (manzana y rocas)
+struct Sprite {
+    SDL_Texture* texture;
+    SDL_Rect srcRect;
+};
+
+// Sistemas de renderizado
+void RenderRockSystem(entt::registry& registry, SDL_Renderer* renderer);
+void RenderSnakeSystem(entt::registry& registry, SDL_Renderer* renderer, float alpha);
+void RenderAppleSystem(entt::registry& registry, SDL_Renderer* renderer);
+void RenderBackgroundSystem(entt::registry& registry, SDL_Renderer* renderer);
+void RenderStaticLayerSystem(entt::registry& registry, SDL_Renderer* renderer);
+
+// Posición del segmento i interpolada entre el tick anterior y el actual (alpha en [0, 1])
+SDL_Point InterpolateSegment(const SnakeBody& snake, size_t i, float alpha);
+
+#endif // RENDERSYSTEMS_H
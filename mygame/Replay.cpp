@@ -0,0 +1,96 @@
+#include "Replay.h"
+#include <cstring>
+#include <iostream>
+
+static const char REPLAY_MAGIC[4] = { 'M', 'G', 'R', 'P' };
+
+bool ReplayRecorder::open(const char* path, Uint64 seed) {
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Error: Could not create replay " << path << std::endl;
+        return false;
+    }
+
+    ReplayHeader header;
+    std::memcpy(header.magic, REPLAY_MAGIC, sizeof(header.magic));
+    header.version = REPLAY_VERSION;
+    header.seed = seed;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.flush();
+    lastTick = 0;
+    return static_cast<bool>(out);
+}
+
+void ReplayRecorder::record(Uint64 tick, Direction direction) {
+    if (!out.is_open()) return;
+    write(tick, static_cast<Uint8>(direction));
+    out.flush();
+}
+
+void ReplayRecorder::close(Uint64 ticks) {
+    if (!out.is_open()) return;
+    write(ticks, REPLAY_END);
+    out.close();
+}
+
+void ReplayRecorder::write(Uint64 tick, Uint8 code) {
+    // Varint LEB128: 7 bits por byte, el bit alto indica que siguen más
+    Uint64 value = ((tick - lastTick) << 3) | code;
+    lastTick = tick;
+    do {
+        Uint8 byte = value & 0x7F;
+        value >>= 7;
+        if (value != 0) byte |= 0x80;
+        out.put(static_cast<char>(byte));
+    } while (value != 0);
+}
+
+bool Replay::load(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    ReplayHeader header;
+    if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, REPLAY_MAGIC, sizeof(header.magic)) != 0 || header.version != REPLAY_VERSION) {
+        std::cerr << "Error: Invalid replay " << path << std::endl;
+        return false;
+    }
+
+    gameSeed = header.seed;
+    totalTicks = 0;
+    hasEnd = false;
+    changes.clear();
+    next = 0;
+
+    Uint64 tick = 0;
+    while (!hasEnd) {
+        Uint64 value = 0;
+        int shift = 0;
+        int c;
+        while ((c = in.get()) != EOF && shift < 64) {
+            value |= static_cast<Uint64>(c & 0x7F) << shift;
+            shift += 7;
+            if (!(c & 0x80)) break;
+        }
+        if (c == EOF || (c & 0x80)) break;  // Fin del archivo o suceso a medio escribir
+
+        tick += value >> 3;
+        Uint8 code = value & 7;
+        if (code == REPLAY_END) {
+            hasEnd = true;
+        } else if (code <= RIGHT) {
+            changes.push_back({ tick, static_cast<Direction>(code) });
+        } else {
+            std::cerr << "Error: Invalid event in replay " << path << std::endl;
+            return false;
+        }
+    }
+
+    totalTicks = tick;
+    return true;
+}
+
+void Replay::apply(Uint64 tick, SnakeBody& snake) {
+    while (next < changes.size() && changes[next].tick <= tick) {
+        snake.direction = changes[next].direction;
+        ++next;
+    }
+}
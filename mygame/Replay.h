@@ -0,0 +1,68 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+// Repeticiones: la semilla de la partida y los cambios de dirección con el tick en que se
+// aplicaron. Como toda la partida sale de la semilla (ver Rng) y de esos cambios, se puede volver
+// a simular igual, con ventana a velocidad real o sin ella lo más rápido posible.
+//
+// Formato: cabecera ReplayHeader y después un varint por suceso con (ticks desde el suceso
+// anterior << 3) | código, donde el código es la Direction o REPLAY_END. REPLAY_END lleva el
+// número total de ticks; si falta (la partida se cortó) la repetición llega hasta el último cambio.
+#include "Game.h"
+#include <fstream>
+#include <vector>
+
+const Uint32 REPLAY_VERSION = 1;
+const Uint8 REPLAY_END = 4;  // Código del suceso final
+
+struct ReplayHeader {
+    char magic[4];  // "MGRP"
+    Uint32 version;
+    Uint64 seed;
+};
+
+// Cambio de dirección: se aplica antes del tick número tick + 1
+struct ReplayEvent {
+    Uint64 tick;
+    Direction direction;
+};
+
+// Grabación: cada cambio se escribe en cuanto ocurre, así la repetición sobrevive a un cierre inesperado
+class ReplayRecorder {
+public:
+    bool open(const char* path, Uint64 seed);
+    // tick es el número de ticks ya ejecutados; direction la dirección ya aceptada
+    void record(Uint64 tick, Direction direction);
+    // Escribir el suceso final con el total de ticks y cerrar
+    void close(Uint64 ticks);
+    bool isOpen() const { return out.is_open(); }
+
+private:
+    void write(Uint64 tick, Uint8 code);
+
+    std::ofstream out;
+    Uint64 lastTick = 0;
+};
+
+class Replay {
+public:
+    bool load(const char* path);
+
+    Uint64 seed() const { return gameSeed; }
+    Uint64 ticks() const { return totalTicks; }
+    bool complete() const { return hasEnd; }
+    const std::vector<ReplayEvent>& events() const { return changes; }
+
+    // Aplicar a la serpiente los cambios registrados hasta tick (los ticks ya ejecutados);
+    // se llama antes de cada SimulationTick
+    void apply(Uint64 tick, SnakeBody& snake);
+
+private:
+    Uint64 gameSeed = 0;
+    Uint64 totalTicks = 0;
+    bool hasEnd = false;
+    std::vector<ReplayEvent> changes;
+    size_t next = 0;  // Siguiente cambio por aplicar
+};
+
+#endif // REPLAY_H
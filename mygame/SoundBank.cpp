@@ -0,0 +1,97 @@
+#include "SoundBank.h"
+#include "AssetPack.h"
+#include "ImaAdpcm.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// Si el WAV es IMA-ADPCM, decodificarlo con nuestro decodificador a PCM de 16 bits.
+// Devuelve false si no lo es (o no se puede leer) para que lo cargue SDL_LoadWAV_RW.
+static bool DecodeImaAdpcmWav(const char* filePath, SDL_AudioSpec& spec, std::vector<Sint16>& pcm) {
+    SDL_RWops* rw = AssetPack::Open(filePath);
+    if (!rw) return false;
+
+    WavInfo wav;
+    bool ok = ReadWavHeader(rw, wav) && IsImaAdpcm(wav);
+    std::vector<Uint8> data;
+    if (ok) {
+        data.resize(wav.dataSize);
+        ok = SDL_RWread(rw, data.data(), 1, data.size()) == data.size();
+    }
+    SDL_RWclose(rw);
+    if (!ok) return false;
+
+    size_t blocks = (data.size() + wav.blockAlign - 1) / wav.blockAlign;
+    pcm.resize(blocks * ImaAdpcmFramesPerBlock(wav.blockAlign, wav.channels) * wav.channels);
+    size_t frames = 0;
+    for (size_t offset = 0; offset < data.size(); offset += wav.blockAlign) {
+        int blockBytes = static_cast<int>(std::min<size_t>(wav.blockAlign, data.size() - offset));
+        frames += DecodeImaAdpcmBlock(data.data() + offset, blockBytes, wav.channels, pcm.data() + frames * wav.channels);
+    }
+    pcm.resize(frames * wav.channels);
+
+    spec.format = AUDIO_S16SYS;
+    spec.channels = static_cast<Uint8>(wav.channels);
+    spec.freq = static_cast<int>(wav.freq);
+    return true;
+}
+
+bool SoundBank::load(const char* const* files, int count, const SDL_AudioSpec& deviceSpec) {
+    bool ok = true;
+    for (int id = 0; id < count; ++id) {
+        if (!appendSound(files[id], deviceSpec)) {
+            entries.push_back({ buffer.size(), 0 });
+            ok = false;
+        }
+    }
+    buffer.shrink_to_fit();
+    return ok;
+}
+
+bool SoundBank::appendSound(const char* filePath, const SDL_AudioSpec& deviceSpec) {
+    SDL_AudioSpec wavSpec;
+    Uint32 wavLength;
+    Uint8* wavBuffer = NULL;
+
+    // IMA-ADPCM lo decodificamos nosotros; el resto de formatos los lee SDL
+    std::vector<Sint16> decoded;
+    const Uint8* source;
+    if (DecodeImaAdpcmWav(filePath, wavSpec, decoded)) {
+        source = reinterpret_cast<const Uint8*>(decoded.data());
+        wavLength = static_cast<Uint32>(decoded.size() * sizeof(Sint16));
+    } else if (SDL_LoadWAV_RW(AssetPack::Open(filePath), 1, &wavSpec, &wavBuffer, &wavLength) != NULL) {
+        source = wavBuffer;
+    } else {
+        std::cerr << "Error al cargar archivo WAV " << filePath << ": " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(&cvt, wavSpec.format, wavSpec.channels, wavSpec.freq,
+                          deviceSpec.format, deviceSpec.channels, deviceSpec.freq) < 0) {
+        std::cerr << "Error al preparar la conversión de " << filePath << ": " << SDL_GetError() << std::endl;
+        if (wavBuffer) SDL_FreeWAV(wavBuffer);
+        return false;
+    }
+
+    // Convertir directamente al final del buffer común, con espacio para el tamaño intermedio
+    size_t offset = buffer.size();
+    size_t workBytes = static_cast<size_t>(wavLength) * cvt.len_mult;
+    buffer.resize(offset + (workBytes + sizeof(Sint16) - 1) / sizeof(Sint16));
+    Uint8* work = reinterpret_cast<Uint8*>(buffer.data() + offset);
+    std::memcpy(work, source, wavLength);
+    if (wavBuffer) SDL_FreeWAV(wavBuffer);
+
+    cvt.buf = work;
+    cvt.len = static_cast<int>(wavLength);
+    if (cvt.needed && SDL_ConvertAudio(&cvt) < 0) {
+        std::cerr << "Error al convertir " << filePath << ": " << SDL_GetError() << std::endl;
+        buffer.resize(offset);
+        return false;
+    }
+    size_t convertedSamples = (cvt.needed ? cvt.len_cvt : cvt.len) / sizeof(Sint16);
+
+    buffer.resize(offset + convertedSamples);
+    entries.push_back({ offset, static_cast<Uint32>(convertedSamples / deviceSpec.channels) });
+    return true;
+}
@@ -0,0 +1,33 @@
+#ifndef SOUNDBANK_H
+#define SOUNDBANK_H
+
+#include <SDL.h>
+#include <vector>
+
+// Banco de sonidos: todos los efectos se cargan una vez al iniciar, se convierten al formato,
+// frecuencia y canales del dispositivo y se guardan seguidos en un único buffer. El juego los
+// identifica con enteros, así que reproducirlos no lee disco, no convierte ni reserva memoria.
+class SoundBank {
+public:
+    // Cargar files[0..count) con los identificadores 0..count-1. Un archivo que falla queda
+    // como sonido vacío para no desplazar los identificadores; en ese caso devuelve false.
+    // Hay que cargar todo antes de empezar a reproducir (el buffer puede moverse al crecer).
+    bool load(const char* const* files, int count, const SDL_AudioSpec& deviceSpec);
+
+    int size() const { return static_cast<int>(entries.size()); }
+    const Sint16* samples(int id) const { return buffer.data() + entries[id].offset; }
+    Uint32 frames(int id) const { return entries[id].frames; }
+
+private:
+    bool appendSound(const char* filePath, const SDL_AudioSpec& deviceSpec);
+
+    struct Entry {
+        size_t offset;  // Primera muestra dentro de buffer
+        Uint32 frames;  // Muestras por canal
+    };
+
+    std::vector<Sint16> buffer;   // Muestras de todos los sonidos, una detrás de otra
+    std::vector<Entry> entries;
+};
+
+#endif // SOUNDBANK_H
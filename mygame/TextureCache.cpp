@@ -0,0 +1,186 @@
+#include "TextureCache.h"
+#include "AssetPack.h"
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+std::string TextureCache::directory;
+Uint32 TextureCache::format = 0;
+
+static const char TEXTURE_CACHE_MAGIC[4] = { 'M', 'G', 'T', 'X' };
+static const Uint32 TEXTURE_CACHE_VERSION = 3;
+static const Uint32 TEXTURE_SOURCE_PACK = 1;
+static const Uint32 TEXTURE_SOURCE_FILE = 2;
+
+// Cabecera de cada archivo de la caché (little endian), seguida de pitch * height bytes
+struct TextureCacheHeader {
+    char magic[4];
+    Uint32 version;
+    Uint32 width;
+    Uint32 height;
+    Uint32 format;      // SDL_PixelFormatEnum
+    Uint32 pitch;
+    Uint32 sourceSize;  // TextureSourceStamp del BMP de origen, para detectar que cambió
+    Uint32 sourceKind;
+    Uint64 sourceStamp;
+};
+
+bool TextureCache::Open(const char* cacheDirectory, SDL_Renderer* renderer) {
+    // Primer formato del renderer con canal alfa; si no hay, ARGB8888 (el que SDL convierte sin pérdidas)
+    SDL_RendererInfo info;
+    format = SDL_PIXELFORMAT_ARGB8888;
+    if (SDL_GetRendererInfo(renderer, &info) == 0) {
+        for (Uint32 i = 0; i < info.num_texture_formats; ++i) {
+            if (SDL_ISPIXELFORMAT_ALPHA(info.texture_formats[i]) && !SDL_ISPIXELFORMAT_FOURCC(info.texture_formats[i])) {
+                format = info.texture_formats[i];
+                break;
+            }
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory, error);
+    if (error) {
+        std::cerr << "Error: Could not create texture cache " << cacheDirectory << ": " << error.message() << std::endl;
+        format = 0;
+        return false;
+    }
+    directory = cacheDirectory;
+    return true;
+}
+
+bool TextureCache::Load(entt::id_type id, const char* name, CachedImage& image, bool& fromCache) {
+    fromCache = false;
+    if (!IsOpen()) return false;
+
+    TextureSourceStamp source = SourceStamp(id, name);
+
+    char fileName[16];
+    SDL_snprintf(fileName, sizeof(fileName), "%08x.tex", static_cast<unsigned>(id));
+    std::string path = directory + "/" + fileName;
+
+    if (source.kind != 0 && ReadEntry(path, source, image)) {
+        fromCache = true;
+        return true;
+    }
+
+    // No está o está desfasada: decodificar, convertir y guardar
+    SDL_Surface* surface = SDL_LoadBMP_RW(AssetPack::Open(id, name), 1);
+    if (!surface) {
+        std::cerr << "Error: Could not load image " << name << ". SDL_Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, format, 0);
+    SDL_FreeSurface(surface);
+    if (!converted) {
+        std::cerr << "Error: Could not convert image " << name << ". SDL_Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    image.width = converted->w;
+    image.height = converted->h;
+    image.format = format;
+    image.pitch = converted->w * SDL_BYTESPERPIXEL(format);
+    image.pixels.resize(static_cast<size_t>(image.pitch) * image.height);
+    SDL_LockSurface(converted);
+    for (int y = 0; y < image.height; ++y) {
+        std::memcpy(&image.pixels[static_cast<size_t>(y) * image.pitch],
+                    static_cast<const Uint8*>(converted->pixels) + static_cast<size_t>(y) * converted->pitch, image.pitch);
+    }
+    SDL_UnlockSurface(converted);
+    SDL_FreeSurface(converted);
+
+    if (source.kind != 0) WriteEntry(path, source, image);
+    return true;
+}
+
+TextureSourceStamp TextureCache::SourceStamp(entt::id_type id, const char* name) {
+    TextureSourceStamp source;
+    if (const AssetPackEntry* entry = AssetPack::FindEntry(id)) {
+        source.size = entry->size;
+        source.kind = TEXTURE_SOURCE_PACK;
+        source.stamp = entry->contentHash;
+        return source;
+    }
+
+    // Suelto: dos consultas de metadatos, sin abrir el archivo
+    std::error_code sizeError;
+    std::error_code timeError;
+    auto size = std::filesystem::file_size(name, sizeError);
+    auto time = std::filesystem::last_write_time(name, timeError);
+    if (!sizeError && !timeError) {
+        source.size = static_cast<Uint32>(size);
+        source.kind = TEXTURE_SOURCE_FILE;
+        source.stamp = static_cast<Uint64>(time.time_since_epoch().count());
+    }
+    return source;
+}
+
+SDL_Texture* TextureCache::Upload(SDL_Renderer* renderer, const CachedImage& image) {
+    SDL_Texture* texture = SDL_CreateTexture(renderer, image.format, SDL_TEXTUREACCESS_STATIC, image.width, image.height);
+    if (!texture) return nullptr;
+
+    if (SDL_UpdateTexture(texture, NULL, image.pixels.data(), image.pitch) != 0) {
+        SDL_DestroyTexture(texture);
+        return nullptr;
+    }
+    // Igual que SDL_CreateTextureFromSurface con una superficie con alfa
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return texture;
+}
+
+bool TextureCache::ReadEntry(const std::string& path, const TextureSourceStamp& source, CachedImage& image) {
+    SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+    if (!file) return false;
+
+    TextureCacheHeader header;
+    bool valid = SDL_RWread(file, &header, sizeof(header), 1) == 1 &&
+                 std::memcmp(header.magic, TEXTURE_CACHE_MAGIC, 4) == 0 &&
+                 header.version == TEXTURE_CACHE_VERSION &&
+                 header.format == format &&
+                 header.sourceSize == source.size &&
+                 header.sourceKind == source.kind &&
+                 header.sourceStamp == source.stamp &&
+                 header.pitch == header.width * SDL_BYTESPERPIXEL(format) &&
+                 SDL_RWsize(file) == static_cast<Sint64>(sizeof(header) + static_cast<Uint64>(header.pitch) * header.height);
+    if (valid) {
+        image.width = static_cast<int>(header.width);
+        image.height = static_cast<int>(header.height);
+        image.format = header.format;
+        image.pitch = static_cast<int>(header.pitch);
+        image.pixels.resize(static_cast<size_t>(header.pitch) * header.height);
+        valid = SDL_RWread(file, image.pixels.data(), 1, image.pixels.size()) == image.pixels.size();
+    }
+    SDL_RWclose(file);
+    return valid;
+}
+
+void TextureCache::WriteEntry(const std::string& path, const TextureSourceStamp& source, const CachedImage& image) {
+    // Escribir en un temporal y renombrar para no dejar entradas a medias
+    std::string temporary = path + ".tmp";
+    SDL_RWops* file = SDL_RWFromFile(temporary.c_str(), "wb");
+    if (!file) return;
+
+    TextureCacheHeader header = {};
+    std::memcpy(header.magic, TEXTURE_CACHE_MAGIC, 4);
+    header.version = TEXTURE_CACHE_VERSION;
+    header.width = static_cast<Uint32>(image.width);
+    header.height = static_cast<Uint32>(image.height);
+    header.format = image.format;
+    header.pitch = static_cast<Uint32>(image.pitch);
+    header.sourceSize = source.size;
+    header.sourceKind = source.kind;
+    header.sourceStamp = source.stamp;
+
+    bool ok = SDL_RWwrite(file, &header, sizeof(header), 1) == 1 &&
+              SDL_RWwrite(file, image.pixels.data(), 1, image.pixels.size()) == image.pixels.size();
+    ok = SDL_RWclose(file) == 0 && ok;
+
+    std::error_code error;
+    if (ok) {
+        std::filesystem::rename(temporary, path, error);
+    }
+    if (!ok || error) {
+        std::filesystem::remove(temporary, error);
+    }
+}
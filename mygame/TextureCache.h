@@ -0,0 +1,54 @@
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include <SDL.h>
+#include <entt/entt.hpp>
+#include <string>
+#include <vector>
+
+// Píxeles de una imagen ya convertidos al formato de textura del renderer
+struct CachedImage {
+    int width = 0;
+    int height = 0;
+    Uint32 format = 0;
+    int pitch = 0;  // Bytes por fila, sin relleno
+    std::vector<Uint8> pixels;
+};
+
+// Caché de texturas en el formato nativo del renderer. La primera vez que se carga un BMP se
+// decodifica, se convierte al formato preferido del renderer y se guarda en el directorio de la
+// caché con una cabecera de ancho, alto y formato. Las siguientes veces cargarla es leer el
+// archivo y hacer un solo SDL_UpdateTexture, sin decodificar ni convertir.
+//
+// La entrada se descarta si cambia el formato del renderer o el origen. Para no leer el origen en
+// cada acierto se compara solo su identidad: en el paquete, el tamaño y el hash del contenido que
+// guarda el índice; suelto, el tamaño y la fecha de modificación del archivo.
+struct TextureSourceStamp {
+    Uint32 size = 0;
+    Uint32 kind = 0;   // TEXTURE_SOURCE_PACK o TEXTURE_SOURCE_FILE; 0 si no se encontró
+    Uint64 stamp = 0;  // Hash del contenido (paquete) o fecha de modificación (archivo suelto)
+};
+
+class TextureCache {
+public:
+    // Activar la caché en directory para las texturas de renderer
+    static bool Open(const char* directory, SDL_Renderer* renderer);
+    static bool IsOpen() { return format != 0; }
+
+    // Leer la imagen de la caché o, si no está o no vale, decodificar el BMP, convertirlo y
+    // guardarlo. Se puede llamar desde cualquier hilo. fromCache indica de dónde salió.
+    static bool Load(entt::id_type id, const char* name, CachedImage& image, bool& fromCache);
+
+    // Crear la textura con una sola subida de píxeles; en el hilo de render
+    static SDL_Texture* Upload(SDL_Renderer* renderer, const CachedImage& image);
+
+private:
+    static TextureSourceStamp SourceStamp(entt::id_type id, const char* name);
+    static bool ReadEntry(const std::string& path, const TextureSourceStamp& source, CachedImage& image);
+    static void WriteEntry(const std::string& path, const TextureSourceStamp& source, const CachedImage& image);
+
+    static std::string directory;
+    static Uint32 format;  // Formato de las texturas del renderer; 0 si la caché está desactivada
+};
+
+#endif // TEXTURECACHE_H
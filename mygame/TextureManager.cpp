@@ -1,40 +1,502 @@
 #include "TextureManager.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <limits>
 
-std::map<std::string, Texture*> TextureManager::textures;
+std::vector<TextureManager::TextureSlot> TextureManager::slots;
+std::vector<Uint32> TextureManager::freeSlots;
+IdMap<Uint32> TextureManager::slotsById;
+size_t TextureManager::memoryBudget = std::numeric_limits<size_t>::max();
+Uint64 TextureManager::currentFrame = 1;
+TextureCacheStats TextureManager::stats;
+bool TextureManager::logLoads = false;
+SDL_Texture* TextureManager::atlas = nullptr;
+size_t TextureManager::atlasBytes = 0;
+IdMap<AtlasSprite> TextureManager::sprites;
+SDL_Thread* TextureManager::loaderThread = nullptr;
+SDL_mutex* TextureManager::loaderMutex = nullptr;
+SDL_cond* TextureManager::loaderCondition = nullptr;
+bool TextureManager::loaderQuit = false;
+std::deque<std::shared_ptr<AsyncTextureState>> TextureManager::decodeQueue;
+std::deque<std::shared_ptr<AsyncTextureState>> TextureManager::uploadQueue;
+IdMap<std::shared_ptr<AsyncTextureState>> TextureManager::pendingTextures;
 
-Texture* TextureManager::LoadTexture(const std::string& filename, SDL_Renderer* renderer) {
-    auto it = textures.find(filename);
+// Separación entre sprites dentro del atlas para que el filtrado no mezcle vecinos
+static const int ATLAS_PADDING = 1;
 
-    if (it != textures.end()) {
-        return it->second;
+// Superficie con una copia de los píxeles de la caché, para componer el atlas
+static SDL_Surface* SurfaceFromImage(const CachedImage& image) {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, image.width, image.height, SDL_BITSPERPIXEL(image.format), image.format);
+    if (!surface) return nullptr;
+
+    SDL_LockSurface(surface);
+    for (int y = 0; y < image.height; ++y) {
+        std::memcpy(static_cast<Uint8*>(surface->pixels) + static_cast<size_t>(y) * surface->pitch,
+                    &image.pixels[static_cast<size_t>(y) * image.pitch], image.pitch);
+    }
+    SDL_UnlockSurface(surface);
+    return surface;
+}
+
+// Memoria de una textura según su tamaño y formato
+static size_t TextureBytes(SDL_Texture* texture) {
+    Uint32 format = 0;
+    int width = 0;
+    int height = 0;
+    SDL_QueryTexture(texture, &format, NULL, &width, &height);
+    return static_cast<size_t>(width) * height * SDL_BYTESPERPIXEL(format);
+}
+
+TextureHandle TextureManager::AddTexture(entt::id_type id, const std::string& filename, const Texture& texture,
+                                         SDL_Renderer* renderer, int references) {
+    Uint32 index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        index = static_cast<Uint32>(slots.size());
+        slots.emplace_back();
+    }
+
+    TextureSlot& slot = slots[index];
+    slot.texture = texture;
+    slot.id = id;
+    slot.filename = filename;
+    slot.refCount = references;
+    slot.renderer = renderer;
+    slot.bytes = TextureBytes(texture.sdlTexture);
+    slot.lastUsedFrame = currentFrame;
+    slotsById.insert(id, index);
+
+    stats.residentBytes += slot.bytes;
+    EnforceBudget(index);
+    return { index, slot.generation };
+}
+
+TextureHandle TextureManager::AddReferences(Uint32 index, int references) {
+    slots[index].refCount += references;
+    return { index, slots[index].generation };
+}
+
+bool TextureManager::DecodeImage(entt::id_type id, const std::string& filename, SDL_Surface*& surface, CachedImage& image, bool& fromCache) {
+    // Con la caché activa se obtienen píxeles en el formato del renderer; sin ella, el BMP tal cual
+    if (TextureCache::IsOpen()) {
+        return TextureCache::Load(id, filename.c_str(), image, fromCache);
+    }
+
+    fromCache = false;
+    surface = SDL_LoadBMP_RW(AssetPack::Open(id, filename.c_str()), 1);
+    if (!surface) {
+        std::cerr << "Error: Could not load image " << filename << ". SDL_Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TextureManager::CreateTexture(SDL_Surface* surface, const CachedImage& image, const std::string& filename,
+                                   SDL_Renderer* renderer, Texture& texture) {
+    if (surface) {
+        return texture.loadFromSurface(surface, filename, renderer);
+    }
+    return texture.loadFromImage(image, filename, renderer);
+}
+
+bool TextureManager::LoadTextureData(entt::id_type id, const std::string& filename, SDL_Renderer* renderer, Texture& texture) {
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    SDL_Surface* surface = nullptr;
+    CachedImage image;
+    bool fromCache = false;
+    if (!DecodeImage(id, filename, surface, image, fromCache) ||
+        !CreateTexture(surface, image, filename, renderer, texture)) {
+        return false;
+    }
+
+    LogLoad(filename, SDL_GetPerformanceCounter() - start, fromCache);
+    return true;
+}
+
+void TextureManager::LogLoad(const std::string& filename, Uint64 ticks, bool fromCache) {
+    if (!logLoads) return;
+    double milliseconds = ticks * 1000.0 / SDL_GetPerformanceFrequency();
+    std::cout << "Textura " << filename << ": " << milliseconds << " ms (" << (fromCache ? "caché" : "BMP") << ")" << std::endl;
+}
+
+TextureHandle TextureManager::LoadTexture(entt::hashed_string name, SDL_Renderer* renderer) {
+    if (const Uint32* index = slotsById.find(name.value())) {
+        return AddReferences(*index, 1);
     }
 
-    Texture* texture = new Texture();
-    if (!texture->load(filename, renderer)) {
-        delete texture;
+    Texture texture;
+    if (!LoadTextureData(name.value(), name.data(), renderer, texture)) {
+        return TextureHandle();
+    }
+
+    return AddTexture(name.value(), name.data(), texture, renderer, 1);
+}
+
+void TextureManager::UnloadTexture(TextureHandle handle) {
+    TextureSlot* found = FindSlot(handle);
+    if (!found) return;
+
+    TextureSlot& slot = *found;
+    if (--slot.refCount > 0) return;
+
+    if (slot.texture.sdlTexture) {
+        SDL_DestroyTexture(slot.texture.sdlTexture);
+        stats.residentBytes -= slot.bytes;
+    }
+    slot.texture = Texture();
+    slot.renderer = nullptr;
+    slotsById.erase(slot.id);
+    slot.filename.clear();
+
+    // Invalidar los identificadores que apuntan a esta ranura (la generación 0 está reservada)
+    if (++slot.generation == 0) slot.generation = 1;
+    freeSlots.push_back(handle.index);
+}
+
+TextureManager::TextureSlot* TextureManager::FindSlot(TextureHandle handle) {
+    if (handle.index >= slots.size() || slots[handle.index].generation != handle.generation) {
         return nullptr;
     }
+    return &slots[handle.index];
+}
 
-    textures[filename] = texture;
-    return texture;
+Texture* TextureManager::GetTexture(TextureHandle handle) {
+    TextureSlot* slot = FindSlot(handle);
+    if (!slot) return nullptr;
+
+    slot->lastUsedFrame = currentFrame;
+    if (slot->texture.sdlTexture) {
+        ++stats.hits;
+        return &slot->texture;
+    }
+
+    // Expulsada por el presupuesto: volver a cargarla
+    ++stats.misses;
+    if (!LoadTextureData(slot->id, slot->filename, slot->renderer, slot->texture)) {
+        return nullptr;
+    }
+
+    stats.residentBytes += slot->bytes;
+    EnforceBudget(handle.index);
+    return &slot->texture;
+}
+
+void TextureManager::SetMemoryBudget(size_t bytes) {
+    memoryBudget = bytes;
+    EnforceBudget(static_cast<Uint32>(slots.size()));
+}
+
+void TextureManager::BeginFrame() {
+    ++currentFrame;
+}
+
+void TextureManager::EnforceBudget(Uint32 keepIndex) {
+    while (stats.residentBytes > memoryBudget) {
+        // La menos usada recientemente entre las cargadas que no se han usado en este frame
+        TextureSlot* oldest = nullptr;
+        for (Uint32 i = 0; i < slots.size(); ++i) {
+            TextureSlot& slot = slots[i];
+            if (i == keepIndex || !slot.texture.sdlTexture || slot.lastUsedFrame >= currentFrame) continue;
+            if (!oldest || slot.lastUsedFrame < oldest->lastUsedFrame) oldest = &slot;
+        }
+        if (!oldest) break;  // Todo lo cargado está en uso: se tolera pasar del presupuesto
+
+        SDL_DestroyTexture(oldest->texture.sdlTexture);
+        oldest->texture.sdlTexture = nullptr;
+        stats.residentBytes -= oldest->bytes;
+        ++stats.evictions;
+    }
+}
+
+void TextureManager::AddPinnedBytes(size_t bytes) {
+    stats.residentBytes += bytes;
+    stats.pinnedBytes += bytes;
+    // Lo fijo no se expulsa: se hace sitio con las texturas cargadas
+    EnforceBudget(static_cast<Uint32>(slots.size()));
+}
+
+void TextureManager::RemovePinnedBytes(size_t bytes) {
+    stats.residentBytes -= bytes;
+    stats.pinnedBytes -= bytes;
+}
+
+TextureFuture TextureManager::LoadTextureAsync(entt::hashed_string name) {
+    auto state = std::make_shared<AsyncTextureState>();
+    state->id = name.value();
+    state->filename = name.data();
+
+    // Ya cargada: el resultado está listo desde el principio
+    if (const Uint32* index = slotsById.find(state->id)) {
+        state->texture = AddReferences(*index, 1);
+        state->done = true;
+        return TextureFuture(state);
+    }
+
+    // Ya pedida: compartir la misma carga
+    if (auto* pending = pendingTextures.find(state->id)) {
+        ++(*pending)->references;
+        return TextureFuture(*pending);
+    }
+
+    // El hilo de carga se arranca con la primera petición
+    if (!loaderThread) {
+        loaderQuit = false;
+        loaderMutex = SDL_CreateMutex();
+        loaderCondition = SDL_CreateCond();
+        if (loaderMutex && loaderCondition) {
+            loaderThread = SDL_CreateThread(LoaderThread, "textures", nullptr);
+        }
+        if (!loaderThread) {
+            std::cerr << "Error: Could not start texture loader thread. SDL_Error: " << SDL_GetError() << std::endl;
+            StopLoader();
+            state->done = true;
+            return TextureFuture(state);
+        }
+    }
+
+    pendingTextures.insert(state->id, state);
+    SDL_LockMutex(loaderMutex);
+    decodeQueue.push_back(state);
+    SDL_CondSignal(loaderCondition);
+    SDL_UnlockMutex(loaderMutex);
+    return TextureFuture(state);
+}
+
+int SDLCALL TextureManager::LoaderThread(void*) {
+    Profiler::SetThreadName("textures");
+    SDL_LockMutex(loaderMutex);
+    while (true) {
+        while (!loaderQuit && decodeQueue.empty()) {
+            SDL_CondWait(loaderCondition, loaderMutex);
+        }
+        if (loaderQuit) break;
+
+        auto state = decodeQueue.front();
+        decodeQueue.pop_front();
+
+        // Decodificar fuera del cerrojo; crear la textura queda para el hilo de render
+        SDL_UnlockMutex(loaderMutex);
+        PROFILE_SCOPE("TextureManager::DecodeImage");
+        const Uint64 start = SDL_GetPerformanceCounter();
+        SDL_Surface* surface = nullptr;
+        CachedImage image;
+        bool fromCache = false;
+        DecodeImage(state->id, state->filename, surface, image, fromCache);
+        Uint64 decodeTicks = SDL_GetPerformanceCounter() - start;
+        SDL_LockMutex(loaderMutex);
+
+        state->surface = surface;
+        state->image = std::move(image);
+        state->fromCache = fromCache;
+        state->decodeTicks = decodeTicks;
+        uploadQueue.push_back(state);
+    }
+    SDL_UnlockMutex(loaderMutex);
+    return 0;
 }
 
-void TextureManager::UnloadTexture(const std::string& filename) {
-    auto it = textures.find(filename);
+void TextureManager::ProcessUploads(SDL_Renderer* renderer, float budgetMs) {
+    if (!loaderThread) return;
+    PROFILE_SCOPE("TextureManager::ProcessUploads");
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const Uint64 budget = static_cast<Uint64>(budgetMs * SDL_GetPerformanceFrequency() / 1000.0f);
+
+    while (true) {
+        std::shared_ptr<AsyncTextureState> state;
+        SDL_LockMutex(loaderMutex);
+        if (!uploadQueue.empty()) {
+            state = uploadQueue.front();
+            uploadQueue.pop_front();
+        }
+        SDL_UnlockMutex(loaderMutex);
+        if (!state) break;
+
+        if (const Uint32* index = slotsById.find(state->id)) {
+            // Se cargó de forma síncrona mientras tanto
+            if (state->surface) SDL_FreeSurface(state->surface);
+            state->texture = AddReferences(*index, state->references);
+        } else if (state->surface || !state->image.pixels.empty()) {
+            const Uint64 uploadStart = SDL_GetPerformanceCounter();
+            Texture texture;
+            if (CreateTexture(state->surface, state->image, state->filename, renderer, texture)) {
+                state->texture = AddTexture(state->id, state->filename, texture, renderer, state->references);
+                LogLoad(state->filename, state->decodeTicks + SDL_GetPerformanceCounter() - uploadStart, state->fromCache);
+            }
+        }
+        state->surface = nullptr;
+        state->image = CachedImage();
+        state->done = true;
+        pendingTextures.erase(state->id);
 
-    if (it != textures.end()) {
-        delete it->second;
-        textures.erase(it);
+        if (SDL_GetPerformanceCounter() - start >= budget) break;
     }
 }
 
-Texture* TextureManager::GetTexture(const std::string& filename) {
-    auto it = textures.find(filename);
+void TextureManager::StopLoader() {
+    if (loaderThread) {
+        SDL_LockMutex(loaderMutex);
+        loaderQuit = true;
+        SDL_CondSignal(loaderCondition);
+        SDL_UnlockMutex(loaderMutex);
+        SDL_WaitThread(loaderThread, NULL);
+        loaderThread = nullptr;
+    }
+
+    // Las cargas que no llegaron a subirse quedan como fallidas
+    for (auto& state : uploadQueue) {
+        if (state->surface) SDL_FreeSurface(state->surface);
+        state->surface = nullptr;
+    }
+    pendingTextures.forEach([](entt::id_type, std::shared_ptr<AsyncTextureState>& state) {
+        state->done = true;
+    });
+    decodeQueue.clear();
+    uploadQueue.clear();
+    pendingTextures.clear();
 
-    if (it != textures.end()) {
-        return it->second;
+    if (loaderCondition) {
+        SDL_DestroyCond(loaderCondition);
+        loaderCondition = nullptr;
+    }
+    if (loaderMutex) {
+        SDL_DestroyMutex(loaderMutex);
+        loaderMutex = nullptr;
     }
+}
+
+bool TextureManager::BuildAtlas(const std::vector<entt::hashed_string>& names, SDL_Renderer* renderer) {
+    UnloadAtlas();
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    struct PendingSprite {
+        entt::hashed_string name;
+        SDL_Surface* surface;
+        SDL_Rect rect;
+    };
+    std::vector<PendingSprite> pending;
+    int totalArea = 0;
+    int widest = 0;
+    bool allFromCache = true;
+
+    for (const auto& name : names) {
+        // Dos nombres con el mismo hash ocuparían la misma entrada de la tabla de sprites
+        for (const auto& other : pending) {
+            if (other.name.value() == name.value()) {
+                std::cerr << "Error: Asset hash collision between " << other.name.data() << " and " << name.data() << std::endl;
+                for (auto& sprite : pending) SDL_FreeSurface(sprite.surface);
+                return false;
+            }
+        }
+
+        // Con la caché activa cada imagen llega ya decodificada y convertida
+        SDL_Surface* surface = nullptr;
+        CachedImage image;
+        bool fromCache = false;
+        if (DecodeImage(name.value(), name.data(), surface, image, fromCache) && !surface) {
+            surface = SurfaceFromImage(image);
+            if (!surface) {
+                std::cerr << "Error: Could not create surface for " << name.data() << ". SDL_Error: " << SDL_GetError() << std::endl;
+            }
+        }
+        if (!surface) {
+            for (auto& sprite : pending) SDL_FreeSurface(sprite.surface);
+            return false;
+        }
+        allFromCache = allFromCache && fromCache;
+        pending.push_back({ name, surface, { 0, 0, surface->w, surface->h } });
+        totalArea += (surface->w + ATLAS_PADDING) * (surface->h + ATLAS_PADDING);
+        widest = std::max(widest, surface->w + ATLAS_PADDING);
+    }
+
+    // Empaquetado por estantes: de más alto a más bajo, llenando filas de izquierda a derecha
+    std::sort(pending.begin(), pending.end(), [](const PendingSprite& a, const PendingSprite& b) {
+        return a.rect.h > b.rect.h;
+    });
+
+    int atlasWidth = 1;
+    while (atlasWidth * atlasWidth < totalArea || atlasWidth < widest) atlasWidth *= 2;
+
+    int x = 0;
+    int y = 0;
+    int shelfHeight = 0;
+    for (auto& sprite : pending) {
+        if (x + sprite.rect.w > atlasWidth) {
+            x = 0;
+            y += shelfHeight + ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+        sprite.rect.x = x;
+        sprite.rect.y = y;
+        x += sprite.rect.w + ATLAS_PADDING;
+        shelfHeight = std::max(shelfHeight, sprite.rect.h);
+    }
+
+    int atlasHeight = 1;
+    while (atlasHeight < y + shelfHeight) atlasHeight *= 2;
+
+    // Copiar cada imagen a su hueco en una superficie RGBA y crear una sola textura
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlasSurface) {
+        std::cerr << "Error: Could not create atlas surface. SDL_Error: " << SDL_GetError() << std::endl;
+        for (auto& sprite : pending) SDL_FreeSurface(sprite.surface);
+        return false;
+    }
+    SDL_FillRect(atlasSurface, NULL, 0);
+
+    for (auto& sprite : pending) {
+        SDL_SetSurfaceBlendMode(sprite.surface, SDL_BLENDMODE_NONE);
+        SDL_Rect dstRect = sprite.rect;
+        SDL_BlitSurface(sprite.surface, NULL, atlasSurface, &dstRect);
+        SDL_FreeSurface(sprite.surface);
+    }
+
+    atlas = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+    SDL_FreeSurface(atlasSurface);
+    if (!atlas) {
+        std::cerr << "Error: Could not create atlas texture. SDL_Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    atlasBytes = TextureBytes(atlas);
+    AddPinnedBytes(atlasBytes);
+
+    for (auto& sprite : pending) {
+        sprites.insert(sprite.name.value(), { atlas, sprite.rect });
+    }
+    LogLoad("atlas (" + std::to_string(pending.size()) + " BMP)", SDL_GetPerformanceCounter() - start, allFromCache);
+    return true;
+}
+
+void TextureManager::UnloadAtlas() {
+    if (atlas) {
+        SDL_DestroyTexture(atlas);
+        atlas = nullptr;
+        RemovePinnedBytes(atlasBytes);
+        atlasBytes = 0;
+    }
+    sprites.clear();
+}
+
+const AtlasSprite* TextureManager::GetSprite(entt::id_type id) {
+    return sprites.find(id);
+}
+
+SDL_Texture* TextureManager::CreateTargetTexture(SDL_Renderer* renderer, int width, int height) {
+    if (!SDL_RenderTargetSupported(renderer)) return nullptr;
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (texture) AddPinnedBytes(TextureBytes(texture));
+    return texture;
+}
 
-    return nullptr;
+void TextureManager::DestroyTargetTexture(SDL_Texture* texture) {
+    if (!texture) return;
+    RemovePinnedBytes(TextureBytes(texture));
+    SDL_DestroyTexture(texture);
 }
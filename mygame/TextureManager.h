@@ -2,24 +2,34 @@
 #define TEXTUREMANAGER_H
 
 #include <SDL.h>
-#include <map>
+#include "AssetPack.h"
+#include "IdMap.h"
+#include "TextureCache.h"
+#include <deque>
+#include <memory>
 #include <string>
+#include <vector>
 #include <iostream>
 
 class Texture {
 public:
-    SDL_Texture* sdlTexture;
-    int width;
-    int height;
+    SDL_Texture* sdlTexture = nullptr;
+    int width = 0;
+    int height = 0;
 
     bool load(const std::string& filename, SDL_Renderer* renderer) {
-        SDL_Surface* tempSurface = SDL_LoadBMP(filename.c_str());
+        SDL_Surface* tempSurface = SDL_LoadBMP_RW(AssetPack::Open(filename.c_str()), 1);
         if (!tempSurface) {
             std::cerr << "Error: Could not load image " << filename << ". SDL_Error: " << SDL_GetError() << std::endl;
             return false;
         }
-        sdlTexture = SDL_CreateTextureFromSurface(renderer, tempSurface);
-        SDL_FreeSurface(tempSurface);
+        return loadFromSurface(tempSurface, filename, renderer);
+    }
+
+    // Crear la textura a partir de una superficie ya decodificada; libera la superficie
+    bool loadFromSurface(SDL_Surface* surface, const std::string& filename, SDL_Renderer* renderer) {
+        sdlTexture = SDL_CreateTextureFromSurface(renderer, surface);
+        SDL_FreeSurface(surface);
 
         if (!sdlTexture) {
             std::cerr << "Error: Could not create texture from " << filename << ". SDL_Error: " << SDL_GetError() << std::endl;
@@ -30,16 +40,164 @@ public:
         return true;
     }
 
+    // Crear la textura a partir de píxeles ya en el formato del renderer (TextureCache)
+    bool loadFromImage(const CachedImage& image, const std::string& filename, SDL_Renderer* renderer) {
+        sdlTexture = TextureCache::Upload(renderer, image);
+        if (!sdlTexture) {
+            std::cerr << "Error: Could not upload texture " << filename << ". SDL_Error: " << SDL_GetError() << std::endl;
+            return false;
+        }
+
+        width = image.width;
+        height = image.height;
+        return true;
+    }
+};
+
+// Identificador de una textura: índice de su ranura y generación de la ranura. Al destruir una
+// textura la generación de su ranura avanza, así que los identificadores viejos dejan de valer.
+struct TextureHandle {
+    Uint32 index = 0;
+    Uint32 generation = 0;  // 0 es el identificador nulo
+
+    bool valid() const { return generation != 0; }
+};
+
+// Estado compartido de una carga asíncrona
+struct AsyncTextureState {
+    entt::id_type id = 0;
+    std::string filename;
+    SDL_Surface* surface = nullptr;  // Lo rellena el hilo de carga (sin TextureCache)
+    CachedImage image;               // Lo rellena el hilo de carga (con TextureCache)
+    bool fromCache = false;
+    Uint64 decodeTicks = 0;          // Tiempo del hilo de carga, en ticks de SDL_GetPerformanceCounter
+    TextureHandle texture;           // Lo rellena ProcessUploads en el hilo de render
+    int references = 1;              // Peticiones que comparten la carga (referencias a sumar)
+    bool done = false;               // Carga terminada, con o sin éxito
 };
 
+// Resultado de LoadTextureAsync, parecido a un future: se consulta sin bloquear desde el hilo
+// de render. Mientras no esté lista, los sistemas dibujan algo provisional.
+class TextureFuture {
+public:
+    TextureFuture() = default;
+    explicit TextureFuture(std::shared_ptr<AsyncTextureState> state) : state(std::move(state)) {}
+
+    bool ready() const { return state && state->texture.valid(); }
+    bool failed() const { return state && state->done && !state->texture.valid(); }
+    TextureHandle get() const { return state ? state->texture : TextureHandle(); }
+
+private:
+    std::shared_ptr<AsyncTextureState> state;
+};
+
+// Contadores de la caché de texturas, para ajustar el presupuesto
+struct TextureCacheStats {
+    Uint64 hits = 0;          // GetTexture con la textura en memoria
+    Uint64 misses = 0;        // GetTexture que tuvo que volver a cargarla
+    Uint64 evictions = 0;     // Texturas expulsadas por el presupuesto
+    size_t residentBytes = 0; // Suma de ancho * alto * bytes por píxel de las texturas en memoria
+    size_t pinnedBytes = 0;   // Parte de residentBytes que no se puede expulsar (atlas y texturas de destino)
+};
+
+// Sprite dentro del atlas: textura compartida y rectángulo de origen
+struct AtlasSprite {
+    SDL_Texture* atlas = nullptr;
+    SDL_Rect srcRect = { 0, 0, 0, 0 };
+};
+
+// Las texturas viven en un arreglo denso de ranuras y se reparten como TextureHandle con un
+// contador de referencias: cada LoadTexture suma una y cada UnloadTexture la resta. Al llegar a
+// cero se llama a SDL_DestroyTexture y la ranura se reutiliza.
+//
+// Los recursos se nombran con entt::hashed_string (ver Assets.h), con el hash calculado en
+// compilación; las tablas internas son IdMap con claves enteras, sin comparar cadenas.
+//
+// Con un presupuesto de memoria, cuando las texturas cargadas lo superan se liberan las usadas
+// hace más tiempo (y no en el frame actual). Su identificador sigue valiendo: el siguiente
+// GetTexture la vuelve a cargar desde el disco o el paquete de recursos. El atlas y las texturas
+// de destino cuentan para el presupuesto pero nunca se expulsan.
 class TextureManager {
 public:
-    static Texture* LoadTexture(const std::string& filename, SDL_Renderer* renderer);
-    static void UnloadTexture(const std::string& filename);
-    static Texture* GetTexture(const std::string& filename);
+    // Cargar (o compartir si ya está cargada) y sumar una referencia. Identificador nulo si falla.
+    static TextureHandle LoadTexture(entt::hashed_string name, SDL_Renderer* renderer);
+    // Restar una referencia; con la última se destruye la textura
+    static void UnloadTexture(TextureHandle handle);
+    // Textura del identificador, o nullptr si ya se destruyó. El puntero vale hasta la siguiente carga.
+    static Texture* GetTexture(TextureHandle handle);
+
+    // Presupuesto en bytes de las texturas cargadas (sin límite por defecto). Las texturas usadas
+    // desde el último BeginFrame no se expulsan.
+    static void SetMemoryBudget(size_t bytes);
+    static void BeginFrame();
+    static const TextureCacheStats& GetStats() { return stats; }
+
+    // Escribir en la consola el tiempo de cada carga (para medir el arranque)
+    static void SetLoadLogging(bool enabled) { logLoads = enabled; }
+
+    // Carga asíncrona: un hilo decodifica el BMP y ProcessUploads crea la textura en el hilo de
+    // render, una vez por frame y sin pasar de budgetMs milisegundos (como mínimo una subida).
+    // Cada petición suma una referencia cuando la textura llega.
+    static TextureFuture LoadTextureAsync(entt::hashed_string name);
+    static void ProcessUploads(SDL_Renderer* renderer, float budgetMs);
+    static void StopLoader();
+
+    // Empaquetar varias imágenes pequeñas en una sola textura para dibujarlas sin cambiar de textura.
+    // Con TextureCache abierta cada imagen sale de la caché, como las texturas sueltas.
+    static bool BuildAtlas(const std::vector<entt::hashed_string>& names, SDL_Renderer* renderer);
+    static void UnloadAtlas();
+    static const AtlasSprite* GetSprite(entt::id_type id);
+
+    // Textura de destino (SDL_TEXTUREACCESS_TARGET) contada en el presupuesto; se destruye con
+    // DestroyTargetTexture. nullptr si el renderer no las admite o falla.
+    static SDL_Texture* CreateTargetTexture(SDL_Renderer* renderer, int width, int height);
+    static void DestroyTargetTexture(SDL_Texture* texture);
 
 private:
-    static std::map<std::string, Texture*> textures;
+    struct TextureSlot {
+        Texture texture;
+        entt::id_type id = 0;
+        std::string filename;
+        SDL_Renderer* renderer = nullptr;  // Para volver a cargarla tras expulsarla
+        size_t bytes = 0;                  // Memoria que ocupa cuando está cargada
+        Uint64 lastUsedFrame = 0;
+        Uint32 generation = 1;
+        int refCount = 0;  // 0 si la ranura está libre
+    };
+
+    static int SDLCALL LoaderThread(void* userdata);
+    static TextureHandle AddTexture(entt::id_type id, const std::string& filename, const Texture& texture,
+                                    SDL_Renderer* renderer, int references);
+    static TextureHandle AddReferences(Uint32 index, int references);
+    static TextureSlot* FindSlot(TextureHandle handle);
+    static bool DecodeImage(entt::id_type id, const std::string& filename, SDL_Surface*& surface, CachedImage& image, bool& fromCache);
+    static bool CreateTexture(SDL_Surface* surface, const CachedImage& image, const std::string& filename,
+                              SDL_Renderer* renderer, Texture& texture);
+    static bool LoadTextureData(entt::id_type id, const std::string& filename, SDL_Renderer* renderer, Texture& texture);
+    static void LogLoad(const std::string& filename, Uint64 ticks, bool fromCache);
+    static void EnforceBudget(Uint32 keepIndex);
+    static void AddPinnedBytes(size_t bytes);
+    static void RemovePinnedBytes(size_t bytes);
+
+    static std::vector<TextureSlot> slots;
+    static std::vector<Uint32> freeSlots;
+    static IdMap<Uint32> slotsById;  // Ranura de cada recurso cargado, para no cargarlo dos veces
+    static size_t memoryBudget;
+    static Uint64 currentFrame;
+    static TextureCacheStats stats;
+    static bool logLoads;
+    static SDL_Texture* atlas;
+    static size_t atlasBytes;
+    static IdMap<AtlasSprite> sprites;
+
+    // Cargas asíncronas: decodeQueue y uploadQueue se protegen con loaderMutex
+    static SDL_Thread* loaderThread;
+    static SDL_mutex* loaderMutex;
+    static SDL_cond* loaderCondition;
+    static bool loaderQuit;
+    static std::deque<std::shared_ptr<AsyncTextureState>> decodeQueue;  // Pendientes de decodificar
+    static std::deque<std::shared_ptr<AsyncTextureState>> uploadQueue;  // Decodificadas, pendientes de subir
+    static IdMap<std::shared_ptr<AsyncTextureState>> pendingTextures;  // Solo hilo de render
 };
 
 #endif // TEXTUREMANAGER_H
@@ -0,0 +1,75 @@
+#include "TimingHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+TimingHistogram::TimingHistogram(int windowSize)
+    : sessionCounts(BUCKET_COUNT, 0), windowCounts(BUCKET_COUNT, 0), recent(std::max(windowSize, 1), 0) {
+    microsPerTick = 1000000.0 / SDL_GetPerformanceFrequency();
+}
+
+int TimingHistogram::bucketOf(Uint32 micros) {
+    if (micros < LINEAR_BUCKETS) return static_cast<int>(micros);
+
+    // Exponente (bit más alto) y los cuatro bits siguientes como subcubeta
+    int exponent = SDL_MostSignificantBitIndex32(micros);
+    int sub = static_cast<int>(micros >> (exponent - 4)) & (SUB_BUCKETS - 1);
+    return LINEAR_BUCKETS + (exponent - 5) * SUB_BUCKETS + sub;
+}
+
+double TimingHistogram::bucketLimitMs(int bucket) {
+    if (bucket < LINEAR_BUCKETS) return (bucket + 1) / 1000.0;
+
+    int exponent = 5 + (bucket - LINEAR_BUCKETS) / SUB_BUCKETS;
+    int sub = (bucket - LINEAR_BUCKETS) % SUB_BUCKETS;
+    return static_cast<double>(static_cast<Uint64>(SUB_BUCKETS + sub + 1) << (exponent - 4)) / 1000.0;
+}
+
+void TimingHistogram::record(Uint64 ticks) {
+    double micros = ticks * microsPerTick;
+    Uint32 value = micros >= 4294967295.0 ? 0xFFFFFFFFu : static_cast<Uint32>(micros);
+    int bucket = bucketOf(value);
+
+    ++sessionCounts[bucket];
+    ++sessionCount;
+    sessionMax = std::max(sessionMax, value);
+
+    // La muestra más antigua de la ventana deja su sitio a la nueva
+    if (recentCount == recent.size()) {
+        --windowCounts[bucketOf(recent[recentNext])];
+    } else {
+        ++recentCount;
+    }
+    recent[recentNext] = value;
+    ++windowCounts[bucket];
+    recentNext = (recentNext + 1) % recent.size();
+}
+
+TimingSummary TimingHistogram::window() const {
+    Uint32 windowMax = 0;
+    for (size_t i = 0; i < recentCount; ++i) {
+        windowMax = std::max(windowMax, recent[i]);
+    }
+    return summarize(windowCounts, recentCount, windowMax);
+}
+
+TimingSummary TimingHistogram::summarize(const std::vector<Uint32>& counts, Uint64 count, Uint32 maxMicros) {
+    TimingSummary summary;
+    summary.count = count;
+    summary.max = maxMicros / 1000.0;
+    if (count == 0) return summary;
+
+    // Recorrer las cubetas acumulando hasta alcanzar cada percentil
+    const double percentiles[3] = { 0.50, 0.95, 0.99 };
+    double* results[3] = { &summary.p50, &summary.p95, &summary.p99 };
+    Uint64 seen = 0;
+    int next = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT && next < 3; ++bucket) {
+        seen += counts[bucket];
+        while (next < 3 && seen >= std::max<Uint64>(1, static_cast<Uint64>(std::ceil(percentiles[next] * count)))) {
+            // Sin pasar del máximo real, que puede quedar por debajo del límite de la cubeta
+            *results[next] = std::min(bucketLimitMs(bucket), summary.max);
+            ++next;
+        }
+    }
+    return summary;
+}
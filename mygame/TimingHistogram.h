@@ -0,0 +1,54 @@
+#ifndef TIMINGHISTOGRAM_H
+#define TIMINGHISTOGRAM_H
+
+#include <SDL.h>
+#include <vector>
+
+// Resumen de una distribución de duraciones, en milisegundos
+struct TimingSummary {
+    Uint64 count = 0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+// Histograma de duraciones con cubetas logarítmicas: por debajo de 32 µs una cubeta por
+// microsegundo y por encima 16 cubetas por cada potencia de dos (error relativo menor del 7%).
+// Registrar una muestra no reserva memoria, así que se puede usar en cada frame.
+//
+// Guarda dos distribuciones: la de toda la sesión y una ventana deslizante con las últimas
+// windowSize muestras, para ver cómo va el juego ahora y no solo la media desde el arranque.
+// Los percentiles se dan como límite superior de su cubeta; el máximo es exacto.
+class TimingHistogram {
+public:
+    explicit TimingHistogram(int windowSize = 600);
+
+    // Registrar una duración en ticks de SDL_GetPerformanceCounter
+    void record(Uint64 ticks);
+
+    TimingSummary session() const { return summarize(sessionCounts, sessionCount, sessionMax); }
+    TimingSummary window() const;
+
+private:
+    static const int LINEAR_BUCKETS = 32;
+    static const int SUB_BUCKETS = 16;
+    static const int BUCKET_COUNT = LINEAR_BUCKETS + (32 - 5) * SUB_BUCKETS;  // Hasta 2^32 µs
+
+    static int bucketOf(Uint32 micros);
+    static double bucketLimitMs(int bucket);
+    static TimingSummary summarize(const std::vector<Uint32>& counts, Uint64 count, Uint32 maxMicros);
+
+    double microsPerTick = 0.0;
+    std::vector<Uint32> sessionCounts;
+    Uint64 sessionCount = 0;
+    Uint32 sessionMax = 0;
+
+    // Ventana deslizante: anillo con las muestras recientes y sus cubetas
+    std::vector<Uint32> windowCounts;
+    std::vector<Uint32> recent;  // Duraciones en µs
+    size_t recentNext = 0;
+    size_t recentCount = 0;
+};
+
+#endif // TIMINGHISTOGRAM_H
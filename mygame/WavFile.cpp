@@ -0,0 +1,72 @@
+#include "WavFile.h"
+#include <cstring>
+
+static bool ReadChunkId(SDL_RWops* rw, char id[4]) {
+    return SDL_RWread(rw, id, 1, 4) == 4;
+}
+
+bool ReadWavHeader(SDL_RWops* rw, WavInfo& info) {
+    char id[4];
+    if (!ReadChunkId(rw, id) || std::memcmp(id, "RIFF", 4) != 0) return false;
+    SDL_ReadLE32(rw);  // Tamaño del RIFF, no fiable en archivos truncados
+    if (!ReadChunkId(rw, id) || std::memcmp(id, "WAVE", 4) != 0) return false;
+
+    Sint64 fileSize = SDL_RWsize(rw);
+    bool hasFormat = false;
+
+    // Recorrer los bloques: "fmt " describe las muestras y "data" las contiene
+    while (ReadChunkId(rw, id)) {
+        Uint32 chunkSize = SDL_ReadLE32(rw);
+        Sint64 chunkStart = SDL_RWtell(rw);
+
+        if (std::memcmp(id, "fmt ", 4) == 0) {
+            if (chunkSize < 16) return false;
+            info.encoding = SDL_ReadLE16(rw);
+            info.channels = SDL_ReadLE16(rw);
+            info.freq = SDL_ReadLE32(rw);
+            SDL_ReadLE32(rw);  // Bytes por segundo
+            info.blockAlign = SDL_ReadLE16(rw);
+            info.bitsPerSample = SDL_ReadLE16(rw);
+
+            // WAVE_FORMAT_EXTENSIBLE guarda la etiqueta real al principio del GUID del subformato
+            if (info.encoding == WAV_FORMAT_EXTENSIBLE && chunkSize >= 26) {
+                SDL_ReadLE16(rw);  // Tamaño de la extensión
+                SDL_ReadLE16(rw);  // Bits válidos por muestra
+                SDL_ReadLE32(rw);  // Máscara de canales
+                info.encoding = SDL_ReadLE16(rw);
+            }
+            hasFormat = true;
+        } else if (std::memcmp(id, "data", 4) == 0) {
+            if (!hasFormat || info.channels == 0 || info.blockAlign == 0) return false;
+            info.dataOffset = chunkStart;
+
+            // Recortar al tamaño real si el archivo está truncado
+            Uint32 size = chunkSize;
+            if (fileSize >= 0 && chunkStart + size > fileSize) {
+                size = static_cast<Uint32>(fileSize - chunkStart);
+            }
+            info.dataSize = size;
+            return true;
+        }
+
+        // Los bloques están alineados a 2 bytes
+        if (SDL_RWseek(rw, chunkStart + chunkSize + (chunkSize & 1), RW_SEEK_SET) < 0) return false;
+    }
+    return false;
+}
+
+SDL_AudioFormat WavSampleFormat(const WavInfo& info) {
+    if (info.encoding == WAV_FORMAT_PCM) {
+        switch (info.bitsPerSample) {
+            case 8:
+                return AUDIO_U8;
+            case 16:
+                return AUDIO_S16LSB;
+            case 32:
+                return AUDIO_S32LSB;
+        }
+    } else if (info.encoding == WAV_FORMAT_FLOAT && info.bitsPerSample == 32) {
+        return AUDIO_F32LSB;
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+#ifndef WAVFILE_H
+#define WAVFILE_H
+
+#include <SDL.h>
+
+// Etiquetas de formato de la cabecera "fmt " de un WAV
+const Uint16 WAV_FORMAT_PCM = 0x0001;
+const Uint16 WAV_FORMAT_FLOAT = 0x0003;
+const Uint16 WAV_FORMAT_EXTENSIBLE = 0xFFFE;
+
+// Descripción de un WAV leída de su cabecera, sin cargar las muestras
+struct WavInfo {
+    Uint16 encoding = 0;       // Etiqueta de formato (en WAVE_FORMAT_EXTENSIBLE, la del subformato)
+    Uint16 channels = 0;
+    Uint32 freq = 0;
+    Uint16 blockAlign = 0;     // Bytes por bloque (por frame en PCM)
+    Uint16 bitsPerSample = 0;
+    Sint64 dataOffset = 0;     // Posición del primer byte del bloque "data"
+    Uint32 dataSize = 0;       // Bytes de audio en el bloque "data" (puede acabar en un bloque incompleto)
+};
+
+// Leer las cabeceras RIFF de rw hasta el bloque "data". Deja rw al principio de las muestras.
+bool ReadWavHeader(SDL_RWops* rw, WavInfo& info);
+
+// Formato SDL equivalente a las muestras PCM del WAV, o 0 si no es PCM que SDL entienda
+SDL_AudioFormat WavSampleFormat(const WavInfo& info);
+
+#endif // WAVFILE_H
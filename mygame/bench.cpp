@@ -0,0 +1,437 @@
+// Microbenchmarks: mide cada sistema por separado con tamaños parametrizables (longitud de la
+// serpiente, número de rocas, tamaño del tablero, número de texturas) y escribe una línea CSV
+// por caso en la salida estándar. Con --baseline compara con una ejecución guardada y termina
+// con código 1 si algún caso empeora más del umbral.
+//
+// Uso: mygame_bench [--filter TEXTO] [--min-time MS] [--repeats N] [--max-length N]
+//                   [--baseline ARCHIVO.csv] [--threshold PORCENTAJE]
+//
+// Para guardar una base: mygame_bench > base.csv
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include "Game.h"
+#include "BatchSimulator.h"
+#include "Profiler.h"
+#include "RenderSystems.h"
+#include "TextureManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+static const long long SNAKE_LENGTHS[] = { 4, 64, 1024, 16384, 262144, 1048576 };
+static const long long ROCK_COUNTS[] = { 3, 64, 1024, 16384 };
+static const int BOARD_SIZES[][2] = { { GRID_WIDTH, GRID_HEIGHT }, { 64, 64 }, { 256, 256 } };
+static const int BATCH_GAMES = 256;
+static const long long TEXTURE_COUNTS[] = { 16, 256, 4096 };
+static const char* const TEXTURE_DIRECTORY = "mygame_bench_textures";  // Dentro del directorio temporal
+
+// Resultado de un caso
+struct BenchResult {
+    std::string name;
+    long long size;
+    double nsPerOp;
+    long long iterations;  // Iteraciones de cada repetición
+};
+
+// Opciones de la línea de comandos
+struct BenchOptions {
+    std::string filter;
+    double minTimeMs = 50.0;  // Duración mínima de cada repetición
+    int repeats = 5;          // Repeticiones; se toma la mediana
+    long long maxLength = 1048576;
+    std::string baseline;
+    double threshold = 10.0;  // Porcentaje de empeoramiento permitido frente a la base
+};
+
+// Los resultados se acumulan aquí para que el compilador no elimine las operaciones medidas
+static volatile Uint64 benchSink = 0;
+
+// Medir op y añadir el resultado: se calibra el número de iteraciones para que cada repetición
+// dure al menos minTimeMs y se toma la mediana de los nanosegundos por operación de todas las
+// repeticiones. Si una llamada a op hace varias operaciones se indica con opsPerCall.
+template <typename Op>
+static void Measure(const BenchOptions& options, std::vector<BenchResult>& results, const char* name, long long size,
+                    Op op, int opsPerCall = 1) {
+    if (!options.filter.empty() && std::strstr(name, options.filter.c_str()) == nullptr) return;
+
+    using Clock = std::chrono::steady_clock;
+    auto run = [&op](long long iterations) {
+        auto start = Clock::now();
+        for (long long i = 0; i < iterations; ++i) op();
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    };
+
+    // Una llamada de calentamiento para que la calibración no cuente costes de una sola vez
+    op();
+
+    const double target = options.minTimeMs * 1e6;
+    long long iterations = 1;
+    double elapsed = run(iterations);
+    while (elapsed < target) {
+        // Estimar las iteraciones que faltan, sin crecer más de 100 veces de golpe
+        double factor = elapsed > 0.0 ? std::min(100.0, target * 1.2 / elapsed) : 100.0;
+        iterations = std::max(iterations + 1, static_cast<long long>(iterations * factor));
+        elapsed = run(iterations);
+    }
+
+    std::vector<double> samples(1, elapsed / iterations);
+    for (int repeat = 1; repeat < options.repeats; ++repeat) {
+        samples.push_back(run(iterations) / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+    results.push_back({ name, size, samples[samples.size() / 2] / opsPerCall, iterations });
+}
+
+// Crear una partida con una serpiente de length segmentos. Crece con el propio
+// UpdateSnakeMovement recorriendo el tablero en zigzag; a partir de GRID_WIDTH * GRID_HEIGHT
+// segmentos se solapan, lo que no cambia el coste de los sistemas (el tablero marca celdas,
+// no cuenta segmentos).
+static entt::entity CreateBenchGame(entt::registry& registry, long long length) {
+    auto snakeEntity = CreateGame(registry, Rng(1));
+    auto& snake = registry.get<SnakeBody>(snakeEntity);
+
+    // Un hueco de más: al moverse la cabeza nueva entra antes de descartar la cola
+    size_t capacity = 16;
+    while (capacity < static_cast<size_t>(length) + 1) capacity *= 2;
+    snake.reserve(capacity);
+
+    for (long long step = 0; static_cast<long long>(snake.size()) < length; ++step) {
+        snake.direction = step % GRID_WIDTH == GRID_WIDTH - 1 ? DOWN : RIGHT;
+        snake.grow = true;
+        UpdateSnakeMovement(registry);
+    }
+    snake.direction = RIGHT;
+    return snakeEntity;
+}
+
+// Sustituir las rocas de la partida por count rocas repartidas por el tablero
+static void SetRockCount(entt::registry& registry, long long count) {
+    auto& rock = registry.get<Rock>(registry.view<Rock>().front());
+    auto& board = registry.get<Board>(registry.view<Board>().front());
+
+    for (const auto& pos : rock.positions) board.clear(pos, CELL_ROCK);
+    rock.positions.clear();
+    for (long long i = 0; i < count; ++i) {
+        SDL_Point pos = Board::positionOf(static_cast<int>((i * 7) % (GRID_WIDTH * GRID_HEIGHT)));
+        rock.positions.push_back(pos);
+        board.set(pos, CELL_ROCK);
+    }
+    ++rock.version;
+}
+
+static void BenchSimulation(const BenchOptions& options, std::vector<BenchResult>& results) {
+    for (long long length : SNAKE_LENGTHS) {
+        if (length > options.maxLength) continue;
+
+        entt::registry registry;
+        auto snakeEntity = CreateBenchGame(registry, length);
+        const auto& snake = registry.get<SnakeBody>(snakeEntity);
+        const auto& board = registry.get<Board>(registry.view<Board>().front());
+        int appleCounter = 0;
+
+        Measure(options, results, "UpdateSnakeMovement/length", length, [&]() {
+            UpdateSnakeMovement(registry);
+        });
+        Measure(options, results, "CheckSelfCollision/length", length, [&]() {
+            benchSink = benchSink + CheckSelfCollision(snake, board);
+        });
+        Measure(options, results, "CheckCollisionWithApple/length", length, [&]() {
+            benchSink = benchSink + CheckCollisionWithApple(registry, appleCounter);
+        });
+    }
+
+    for (long long count : ROCK_COUNTS) {
+        entt::registry registry;
+        auto snakeEntity = CreateBenchGame(registry, 4);
+        SetRockCount(registry, count);
+        const auto& snake = registry.get<SnakeBody>(snakeEntity);
+        const auto& board = registry.get<Board>(registry.view<Board>().front());
+
+        Measure(options, results, "CheckCollisionWithRock/rocks", count, [&]() {
+            benchSink = benchSink + CheckCollisionWithRock(snake, board);
+        });
+    }
+
+    // UpdateRockMovement vuelve a colocar tres rocas cada ROCK_TICKS, así que no depende del número
+    {
+        entt::registry registry;
+        CreateBenchGame(registry, 4);
+        Measure(options, results, "UpdateRockMovement", 3, [&]() {
+            UpdateRockMovement(registry);
+        });
+    }
+
+    // El tablero de la partida tiene tamaño fijo; los tamaños de tablero se miden con el simulador
+    // por lotes, que aplica las mismas reglas. El tiempo es por partida y tick.
+    for (const auto& size : BOARD_SIZES) {
+        BatchSimulator batch(BATCH_GAMES, 1, size[0], size[1]);
+        std::vector<Uint8> actions(BATCH_GAMES);
+        Uint32 tick = 0;
+
+        Measure(options, results, "BatchSimulator::step/cells", static_cast<long long>(size[0]) * size[1], [&]() {
+            for (int game = 0; game < BATCH_GAMES; ++game) {
+                actions[game] = static_cast<Uint8>(((tick >> 3) + game) & 3);
+            }
+            batch.step(actions.data());
+            ++tick;
+        }, BATCH_GAMES);
+    }
+}
+
+// Crear count imágenes BMP de 8x8 en directory y devolver sus nombres. Se escriben siempre, así
+// lo medido no depende de lo que haya quedado de otra ejecución.
+static bool WriteBenchTextures(const std::filesystem::path& directory, long long count, std::vector<std::string>& paths) {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 8, 8, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        std::cerr << "Error: Could not create benchmark image. SDL_Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    bool ok = true;
+    for (long long i = 0; i < count && ok; ++i) {
+        std::string path = (directory / ("tex_" + std::to_string(i) + ".bmp")).string();
+        SDL_FillRect(surface, NULL, static_cast<Uint32>(0xFF000000u | (i * 2654435761u)));
+        if (SDL_SaveBMP(surface, path.c_str()) != 0) {
+            std::cerr << "Error: Could not write " << path << ". SDL_Error: " << SDL_GetError() << std::endl;
+            ok = false;
+        }
+        paths.push_back(path);
+    }
+    SDL_FreeSurface(surface);
+    return ok;
+}
+
+// Las imágenes se generan en un directorio temporal propio de la ejecución que se borra al terminar
+static bool BenchTextures(const BenchOptions& options, SDL_Renderer* renderer, std::vector<BenchResult>& results) {
+    std::error_code error;
+    std::filesystem::path directory = std::filesystem::temp_directory_path(error);
+    if (error) {
+        std::cerr << "Error: Could not find the temporary directory: " << error.message() << std::endl;
+        return false;
+    }
+    directory /= std::string(TEXTURE_DIRECTORY) + "_" + std::to_string(SDL_GetPerformanceCounter());
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Error: Could not create benchmark texture directory " << directory.string() << ": " << error.message() << std::endl;
+        return false;
+    }
+
+    bool ok = true;
+    for (long long count : TEXTURE_COUNTS) {
+        std::vector<std::string> paths;
+        if (!WriteBenchTextures(directory, count, paths)) {
+            ok = false;
+            break;
+        }
+        std::vector<TextureHandle> handles;
+        std::vector<entt::hashed_string> names;
+        for (const auto& path : paths) {
+            names.push_back(entt::hashed_string{ path.c_str() });
+            handles.push_back(TextureManager::LoadTexture(names.back(), renderer));
+        }
+        if (!TextureManager::BuildAtlas(names, renderer)) {
+            std::cerr << "Error: Could not build the benchmark atlas. SDL_Error: " << SDL_GetError() << std::endl;
+        }
+
+        // Orden de consulta pseudoaleatorio para no recorrer las ranuras siempre en secuencia
+        Rng rng(count);
+        std::vector<Uint32> order(4096);
+        for (auto& index : order) index = rng.below(static_cast<Uint32>(count));
+        size_t next = 0;
+
+        Measure(options, results, "TextureManager::GetTexture/textures", count, [&]() {
+            Texture* texture = TextureManager::GetTexture(handles[order[next++ & 4095]]);
+            benchSink = benchSink + (texture ? texture->width : 0);
+        });
+        Measure(options, results, "TextureManager::GetSprite/sprites", count, [&]() {
+            const AtlasSprite* sprite = TextureManager::GetSprite(names[order[next++ & 4095]].value());
+            benchSink = benchSink + (sprite ? sprite->srcRect.w : 0);
+        });
+        // Cargar una textura ya cargada solo busca su ranura y suma una referencia
+        Measure(options, results, "TextureManager::LoadTexture(loaded)/textures", count, [&]() {
+            Uint32 index = order[next++ & 4095];
+            TextureManager::UnloadTexture(TextureManager::LoadTexture(names[index], renderer));
+        });
+
+        TextureManager::UnloadAtlas();
+        for (TextureHandle handle : handles) TextureManager::UnloadTexture(handle);
+    }
+
+    std::filesystem::remove_all(directory, error);
+    return ok;
+}
+
+static void BenchRendering(const BenchOptions& options, SDL_Renderer* renderer, std::vector<BenchResult>& results) {
+    // Hoja de sprites sintética: cabeza y cuerpo de la serpiente y un sprite para manzana y rocas
+    SDL_Texture* sheet = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 24, 8);
+    std::vector<Uint32> pixels(24 * 8, 0xFF80C040u);
+    SDL_UpdateTexture(sheet, NULL, pixels.data(), 24 * sizeof(Uint32));
+    SDL_SetTextureBlendMode(sheet, SDL_BLENDMODE_BLEND);
+
+    for (long long length : SNAKE_LENGTHS) {
+        if (length > options.maxLength) continue;
+
+        entt::registry registry;
+        auto snakeEntity = CreateBenchGame(registry, length);
+        registry.emplace<SnakeSegment>(snakeEntity, sheet, SDL_Rect{ 0, 0, 16, 8 });
+        registry.emplace<SnakeMesh>(snakeEntity);
+
+        Measure(options, results, "RenderSnakeSystem/length", length, [&]() {
+            RenderSnakeSystem(registry, renderer, 0.5f);
+        });
+    }
+
+    for (long long count : ROCK_COUNTS) {
+        entt::registry registry;
+        CreateBenchGame(registry, 4);
+        SetRockCount(registry, count);
+        registry.emplace<Sprite>(registry.view<Rock>().front(), sheet, SDL_Rect{ 16, 0, 8, 8 });
+
+        Measure(options, results, "RenderRockSystem/rocks", count, [&]() {
+            RenderRockSystem(registry, renderer);
+        });
+    }
+
+    {
+        entt::registry registry;
+        CreateBenchGame(registry, 4);
+        registry.emplace<Sprite>(registry.view<Apple>().front(), sheet, SDL_Rect{ 16, 0, 8, 8 });
+
+        // Sin textura de fondo cargada, RenderBackgroundSystem dibuja el color provisional
+        auto bgEntity = registry.create();
+        registry.emplace<BackgroundTexture>(bgEntity);
+        auto& layer = registry.emplace<StaticLayer>(bgEntity);
+        layer.texture = TextureManager::CreateTargetTexture(renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+        Measure(options, results, "RenderAppleSystem", 1, [&]() {
+            RenderAppleSystem(registry, renderer);
+        });
+        Measure(options, results, "RenderBackgroundSystem", 1, [&]() {
+            RenderBackgroundSystem(registry, renderer);
+        });
+        // Capa ya compuesta: una copia de pantalla completa por frame
+        Measure(options, results, "RenderStaticLayerSystem(cached)", 1, [&]() {
+            RenderStaticLayerSystem(registry, renderer);
+        });
+        // Capa sucia: recomponer fondo y rocas en la textura de destino y copiarla
+        Measure(options, results, "RenderStaticLayerSystem(redraw)", 1, [&]() {
+            registry.get<StaticLayer>(bgEntity).dirty = true;
+            RenderStaticLayerSystem(registry, renderer);
+        });
+
+        TextureManager::DestroyTargetTexture(layer.texture);
+    }
+
+    SDL_DestroyTexture(sheet);
+}
+
+// Leer una ejecución guardada: benchmark,size,ns_per_op[,...]
+static bool LoadBaseline(const std::string& path, std::map<std::pair<std::string, long long>, double>& baseline) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#' || line.compare(0, 10, "benchmark,") == 0) continue;
+
+        std::stringstream fields(line);
+        std::string name, size, nsPerOp;
+        if (std::getline(fields, name, ',') && std::getline(fields, size, ',') && std::getline(fields, nsPerOp, ',')) {
+            baseline[{ name, std::atoll(size.c_str()) }] = std::atof(nsPerOp.c_str());
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            options.minTimeMs = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--repeats") == 0 && i + 1 < argc) {
+            options.repeats = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-length") == 0 && i + 1 < argc) {
+            options.maxLength = std::atoll(argv[++i]);
+        } else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            options.baseline = argv[++i];
+        } else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            options.threshold = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--filter TEXTO] [--min-time MS] [--repeats N] [--max-length N]"
+                      << " [--baseline ARCHIVO.csv] [--threshold PORCENTAJE]" << std::endl;
+            return -1;
+        }
+    }
+
+    std::map<std::pair<std::string, long long>, double> baseline;
+    if (!options.baseline.empty() && !LoadBaseline(options.baseline, baseline)) {
+        std::cerr << "Error: Could not read baseline " << options.baseline << std::endl;
+        return -1;
+    }
+
+    if (SDL_Init(0) != 0) {
+        std::cerr << "Error initializing SDL: " << SDL_GetError() << std::endl;
+        return -1;
+    }
+
+    // Renderer por software sobre una superficie: no necesita ventana ni GPU
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (!renderer) {
+        std::cerr << "Error creating software renderer: " << SDL_GetError() << std::endl;
+        SDL_FreeSurface(target);
+        SDL_Quit();
+        return -1;
+    }
+
+    std::vector<BenchResult> results;
+    BenchSimulation(options, results);
+    if (!BenchTextures(options, renderer, results)) {
+        SDL_DestroyRenderer(renderer);
+        SDL_FreeSurface(target);
+        SDL_Quit();
+        return -1;
+    }
+    BenchRendering(options, renderer, results);
+
+    // Con los marcadores del perfilador activos cada sistema paga dos lecturas del reloj
+    std::cout << "# profiler=" << (Profiler::ENABLED ? "on" : "off") << std::endl;
+    std::cout << "benchmark,size,ns_per_op,iterations" << (baseline.empty() ? "" : ",baseline_ns,change_pct,status") << std::endl;
+
+    int regressions = 0;
+    for (const auto& result : results) {
+        std::cout << result.name << "," << result.size << "," << result.nsPerOp << "," << result.iterations;
+        if (!baseline.empty()) {
+            auto base = baseline.find({ result.name, result.size });
+            if (base == baseline.end() || base->second <= 0.0) {
+                std::cout << ",,,new";
+            } else {
+                double change = (result.nsPerOp - base->second) * 100.0 / base->second;
+                const char* status = change > options.threshold ? "regression" : change < -options.threshold ? "improvement" : "ok";
+                if (change > options.threshold) ++regressions;
+                std::cout << "," << base->second << "," << change << "," << status;
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(target);
+    SDL_Quit();
+
+    if (regressions > 0) {
+        std::cerr << regressions << " caso(s) por encima del umbral del " << options.threshold << "%" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,264 @@
+// Simulación sin ventana: ejecuta la lógica del juego tan rápido como sea posible,
+// controlada por un bot o por una secuencia de direcciones, y mide ticks por segundo.
+//
+// Uso: mygame_headless [--ticks N] [--seed S] [--script UDLR...] [--batch PARTIDAS] [--replay ARCHIVO]
+#include "Game.h"
+#include "BatchSimulator.h"
+#include "Replay.h"
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Distancia en celdas entre dos posiciones teniendo en cuenta que el tablero da la vuelta
+static int WrappedDistance(SDL_Point a, SDL_Point b) {
+    int dx = std::abs(a.x - b.x) / TILE_SIZE;
+    int dy = std::abs(a.y - b.y) / TILE_SIZE;
+    if (dx > GRID_WIDTH / 2) dx = GRID_WIDTH - dx;
+    if (dy > GRID_HEIGHT / 2) dy = GRID_HEIGHT - dy;
+    return dx + dy;
+}
+
+// Bot sencillo: entre las direcciones que no dan media vuelta elige la que más acerca la
+// cabeza a la manzana, evitando las celdas ocupadas por el cuerpo o las rocas
+static Direction ChooseBotDirection(const SnakeBody& snake, const Board& board, SDL_Point apple) {
+    static const Direction directions[] = { UP, DOWN, LEFT, RIGHT };
+    Direction best = snake.direction;
+    int bestScore = -1;
+
+    for (Direction candidate : directions) {
+        if (candidate == OppositeDirection(snake.direction)) continue;
+
+        SDL_Point next = NextHeadPosition(snake.segmentAt(0), candidate, snake.speed);
+        int score = GRID_WIDTH + GRID_HEIGHT - WrappedDistance(next, apple);
+        if (board.has(next, CELL_BODY | CELL_ROCK)) score = 0;
+
+        if (score > bestScore) {
+            bestScore = score;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+// El mismo bot para una partida del simulador por lotes, trabajando con celdas
+static Uint8 ChooseBatchAction(const BatchSimulator& batch, int game) {
+    static const Direction directions[] = { UP, DOWN, LEFT, RIGHT };
+    SDL_Point apple = { (batch.appleCell(game) % batch.width()) * TILE_SIZE, (batch.appleCell(game) / batch.width()) * TILE_SIZE };
+    Direction current = batch.direction(game);
+    Direction best = current;
+    int bestScore = -1;
+
+    for (Direction candidate : directions) {
+        if (candidate == OppositeDirection(current)) continue;
+
+        int x = (batch.headX(game) + (candidate == RIGHT) - (candidate == LEFT) + batch.width()) % batch.width();
+        int y = (batch.headY(game) + (candidate == DOWN) - (candidate == UP) + batch.height()) % batch.height();
+        SDL_Point next = { x * TILE_SIZE, y * TILE_SIZE };
+        int score = GRID_WIDTH + GRID_HEIGHT - WrappedDistance(next, apple);
+        if (batch.cellAt(game, y * batch.width() + x) & (CELL_BODY | CELL_ROCK)) score = 0;
+
+        if (score > bestScore) {
+            bestScore = score;
+            best = candidate;
+        }
+    }
+    return static_cast<Uint8>(best);
+}
+
+// Ejecutar muchas partidas a la vez con el simulador por lotes y medir pasos por segundo
+static int RunBatch(int gameCount, long long totalTicks, Uint64 seed) {
+    BatchSimulator batch(gameCount, seed);
+    std::vector<Uint8> actions(gameCount);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (long long tick = 0; tick < totalTicks; ++tick) {
+        for (int game = 0; game < gameCount; ++game) {
+            actions[game] = ChooseBatchAction(batch, game);
+        }
+        batch.step(actions.data());
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "Partidas simultáneas: " << gameCount << std::endl;
+    std::cout << "Ticks: " << totalTicks << std::endl;
+    std::cout << "Pasos totales: " << batch.totalSteps << std::endl;
+    std::cout << "Partidas terminadas: " << batch.gamesFinished << std::endl;
+    std::cout << "Manzanas: " << batch.applesEaten << std::endl;
+    std::cout << "Tiempo: " << seconds << " s" << std::endl;
+    std::cout << "Pasos por segundo: " << (seconds > 0.0 ? batch.totalSteps / seconds : 0.0) << std::endl;
+
+    return 0;
+}
+
+// Volver a simular una partida grabada por el juego lo más rápido posible. Sin --ticks se
+// detiene donde terminó la grabación; con --ticks sigue hasta ese tick o el final de la partida.
+static int RunReplay(const char* path, long long tickLimit) {
+    Replay replay;
+    if (!replay.load(path)) return -1;
+
+    entt::registry registry;
+    auto snakeEntity = CreateGame(registry, Rng(replay.seed()));
+    Uint64 lastTick = tickLimit > 0 ? static_cast<Uint64>(tickLimit) : replay.ticks();
+    int appleCounter = 0;
+    int events = TICK_NONE;
+    Uint64 tick = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (tick < lastTick && !(events & TICK_GAME_OVER)) {
+        replay.apply(tick, registry.get<SnakeBody>(snakeEntity));
+        events = SimulationTick(registry, appleCounter);
+        ++tick;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "Semilla: " << replay.seed() << std::endl;
+    std::cout << "Cambios de dirección: " << replay.events().size() << (replay.complete() ? "" : " (grabación incompleta)") << std::endl;
+    std::cout << "Ticks: " << tick << " de " << replay.ticks() << " grabados" << std::endl;
+    std::cout << "Manzanas: " << appleCounter << std::endl;
+    std::cout << "Longitud: " << registry.get<SnakeBody>(snakeEntity).size() << std::endl;
+    std::cout << "Final: " << ((events & TICK_HIT_SELF) ? "colisión con el cuerpo" : (events & TICK_HIT_ROCK) ? "colisión con la roca" : "sin colisión") << std::endl;
+    std::cout << "Tiempo: " << seconds << " s" << std::endl;
+    std::cout << "Ticks por segundo: " << (seconds > 0.0 ? tick / seconds : 0.0) << std::endl;
+
+    return 0;
+}
+
+// Convertir una letra del guion (U, D, L, R) en dirección
+static bool ParseDirection(char c, Direction& direction) {
+    switch (c) {
+        case 'U': case 'u': direction = UP; return true;
+        case 'D': case 'd': direction = DOWN; return true;
+        case 'L': case 'l': direction = LEFT; return true;
+        case 'R': case 'r': direction = RIGHT; return true;
+        default: return false;
+    }
+}
+
+static int PrintUsage(const char* program) {
+    std::cerr << "Uso: " << program << " [--ticks N] [--seed S] [--script UDLR...] [--batch PARTIDAS] [--replay ARCHIVO]" << std::endl;
+    std::cerr << "Con --replay solo se admite --ticks: la semilla y las direcciones salen de la grabación" << std::endl;
+    std::cerr << "Con --batch las partidas (un número positivo) las juega el simulador por lotes, sin --script" << std::endl;
+    return -1;
+}
+
+int main(int argc, char* argv[]) {
+    long long totalTicks = 1000000;
+    Uint64 seed = 1;
+    std::string script;
+    int batchGames = 0;
+    const char* replayPath = nullptr;
+    bool ticksGiven = false;
+    bool seedGiven = false;
+    bool scriptGiven = false;
+    bool batchGiven = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            totalTicks = std::atoll(argv[++i]);
+            ticksGiven = true;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+            seedGiven = true;
+        } else if (std::strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            script = argv[++i];
+            scriptGiven = true;
+        } else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            // Un número de partidas no válido (con letras o fuera de rango) queda en 0 y se rechaza abajo
+            char* end = nullptr;
+            long games = std::strtol(argv[++i], &end, 10);
+            batchGames = *end == '\0' && games > 0 && games <= INT_MAX ? static_cast<int>(games) : 0;
+            batchGiven = true;
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else {
+            return PrintUsage(argv[0]);
+        }
+    }
+
+    if (replayPath && (seedGiven || scriptGiven || batchGiven)) {
+        return PrintUsage(argv[0]);
+    }
+    if (batchGiven && (batchGames <= 0 || scriptGiven)) {
+        return PrintUsage(argv[0]);
+    }
+
+    for (char c : script) {
+        Direction direction;
+        if (!ParseDirection(c, direction)) {
+            std::cerr << "Error: invalid direction '" << c << "' in script" << std::endl;
+            return -1;
+        }
+    }
+
+    if (replayPath) {
+        return RunReplay(replayPath, ticksGiven ? totalTicks : 0);
+    }
+
+    if (batchGiven) {
+        return RunBatch(batchGames, totalTicks, seed);
+    }
+
+    // Cada partida nueva usa su propia secuencia, separada de la anterior con jump()
+    Rng streams(seed);
+
+    entt::registry registry;
+    auto snakeEntity = CreateGame(registry, streams);
+    streams.jump();
+
+    int appleCounter = 0;
+    long long games = 1;
+    long long apples = 0;
+    size_t maxLength = 1;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (long long tick = 0; tick < totalTicks; ++tick) {
+        auto& snake = registry.get<SnakeBody>(snakeEntity);
+
+        // Elegir la dirección del siguiente tick, igual que haría el teclado
+        Direction next = snake.direction;
+        if (!script.empty()) {
+            ParseDirection(script[tick % script.size()], next);
+        } else {
+            const auto& board = registry.get<Board>(registry.view<Board>().front());
+            const auto& apple = registry.get<Apple>(registry.view<Apple>().front());
+            next = ChooseBotDirection(snake, board, apple.position);
+        }
+        if (next != OppositeDirection(snake.direction)) snake.direction = next;
+
+        int events = SimulationTick(registry, appleCounter);
+        if (snake.size() > maxLength) maxLength = snake.size();
+
+        // Al terminar una partida se empieza otra con un tablero nuevo
+        if (events & TICK_GAME_OVER) {
+            apples += appleCounter;
+            appleCounter = 0;
+            ++games;
+            registry.clear();
+            snakeEntity = CreateGame(registry, streams);
+            streams.jump();
+        }
+    }
+    apples += appleCounter;
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "Ticks: " << totalTicks << std::endl;
+    std::cout << "Partidas: " << games << std::endl;
+    std::cout << "Manzanas: " << apples << std::endl;
+    std::cout << "Longitud máxima: " << maxLength << std::endl;
+    std::cout << "Tiempo: " << seconds << " s" << std::endl;
+    std::cout << "Ticks por segundo: " << (seconds > 0.0 ? totalTicks / seconds : 0.0) << std::endl;
+
+    return 0;
+}
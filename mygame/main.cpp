@@ -1,366 +1,161 @@
 #define SDL_MAIN_HANDLED
 #include <SDL.h>
 #include <entt/entt.hpp>
+#include "Game.h"
+#include "AssetPack.h"
+#include "Assets.h"
+#include "AudioMixer.h"
+#include "FramePacer.h"
+#include "Profiler.h"
+#include "RenderSystems.h"
+#include "Replay.h"
+#include "TextureCache.h"
 #include "TextureManager.h"
+#include "TimingHistogram.h"
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <cstdlib>
 #include <ctime>
+#include <cmath>
+#include <cstring>
 
-// Definiciones de constantes
-const int SCREEN_WIDTH = 640;
-const int SCREEN_HEIGHT = 480;
-const int TILE_SIZE = 32;
-const float MOVE_DELAY = 0.15f;  // Delay entre movimientos en segundos
-const float ROCK_TIMER = 15.0f;  // Tiempo para cambiar las rocas de lugar
-
-// Direcciones de movimiento
-enum Direction { UP, DOWN, LEFT, RIGHT };
-
-// Componente para almacenar la textura del fondo
-struct BackgroundTexture {
-    SDL_Texture* texture;
-    int width;
-    int height;
-};
-
-// Componente para los segmentos de la serpiente
-struct SnakeSegment {
-    SDL_Texture* texture;
-    SDL_Rect srcRect;
-};
-
-// Componente para manejar la serpiente
-struct SnakeBody {
-    std::vector<SDL_Point> segments;  // Posiciones de todos los segmentos
-    std::vector<Direction> directions; // Direcciones de cada segmento
-    Direction direction;              // Dirección de movimiento de la cabeza
-    int speed = TILE_SIZE;            // Velocidad de la serpiente
-    float moveTimer = 0.0f;           // Temporizador para el movimiento
-    bool grow = false;                // Indica si la serpiente debe crecer
-};
-
-// Componente para la manzana
-struct Apple {
-    SDL_Point position;
-    SDL_Texture* texture;
-};
-
-// Componente para las rocas
-struct Rock {
-    std::vector<SDL_Point> positions; // Posiciones de las rocas
-    SDL_Texture* texture;
-    float timer = 0.0f; // Temporizador para cambiar la posición de las rocas
-};
-
-// Sistema de generación de rocas
-void GenerateRock(entt::registry& registry, SDL_Texture* rockTexture) {
-    auto view = registry.view<Rock>();
-    if (view.empty()) {
-        auto rockEntity = registry.create();
-        registry.emplace<Rock>(rockEntity, std::vector<SDL_Point>(), rockTexture);
-    }
-
-    auto rockEntity = view.front();
-    auto& rock = registry.get<Rock>(rockEntity);
-
-    // Limitar las posiciones aleatorias para asegurarse de que no se salgan de la pantalla
-    int startX = (rand() % ((SCREEN_WIDTH - 2 * TILE_SIZE) / TILE_SIZE)) * TILE_SIZE;
-    int startY = (rand() % ((SCREEN_HEIGHT - 2 * TILE_SIZE) / TILE_SIZE)) * TILE_SIZE;
-
-    // Colocar los tres tiles consecutivos en dirección horizontal o vertical
-    rock.positions.clear();
-    if (rand() % 2 == 0) {  // Horizontal
-        rock.positions.push_back({startX, startY});
-        rock.positions.push_back({startX + TILE_SIZE, startY});
-        rock.positions.push_back({startX + 2 * TILE_SIZE, startY});
-    } else {  // Vertical
-        rock.positions.push_back({startX, startY});
-        rock.positions.push_back({startX, startY + TILE_SIZE});
-        rock.positions.push_back({startX, startY + 2 * TILE_SIZE});
-    }
-
-    rock.texture = rockTexture;
-}
-
-
-// Sistema de actualización para cambiar las rocas de lugar cada 15 segundos
-void UpdateRockMovement(entt::registry& registry, float deltaTime, SDL_Texture* rockTexture) {
-    auto view = registry.view<Rock>();
+const int MAX_TICKS_PER_FRAME = 5;  // Límite de ticks por frame para no acumular retraso sin fin
+const float TEXTURE_UPLOAD_BUDGET_MS = 2.0f;  // Tiempo máximo por frame para subir texturas cargadas en segundo plano
+const size_t TEXTURE_MEMORY_BUDGET = 64 * 1024 * 1024;  // Bytes de texturas cargadas antes de expulsar las menos usadas
 
-    for (auto entity : view) {
-        auto& rock = view.get<Rock>(entity);
-        rock.timer += deltaTime;
+// Identificadores de los sonidos del juego, en el mismo orden que SOUND_FILES
+enum SoundId { SOUND_EAT_APPLE, SOUND_COUNT };
+const char* const SOUND_FILES[SOUND_COUNT] = { Assets::EAT_APPLE_SOUND.data() };
 
-        if (rock.timer >= ROCK_TIMER) {
-            // Cambiar la posición de las rocas después de 15 segundos
-            GenerateRock(registry, rockTexture);
-            rock.timer = 0.0f;  // Reiniciar el temporizador
-        }
+// Reproducir la música de fondo en bucle, leyéndola del disco por trozos
+void PlayBackgroundMusic(AudioMixer& mixer, MusicStream& music, const char* filePath) {
+    if (music.open(filePath, mixer.spec())) {
+        mixer.setMusic(&music, SDL_MIX_MAXVOLUME / 2);
     }
 }
 
-// Sistema de renderizado para la roca
-void RenderRockSystem(entt::registry& registry, SDL_Renderer* renderer) {
-    auto view = registry.view<Rock>();
-
-    for (auto entity : view) {
-        auto& rock = view.get<Rock>(entity);
-
-        for (auto& pos : rock.positions) {
-            SDL_Rect dstRect = { pos.x, pos.y, TILE_SIZE, TILE_SIZE };
-            SDL_RenderCopy(renderer, rock.texture, NULL, &dstRect);
-        }
-    }
+// Función para reproducir un efecto de sonido del banco
+void PlaySoundEffect(AudioMixer& mixer, const SoundBank& bank, SoundId sound) {
+    mixer.play(bank, sound);
 }
 
-// Verificar colisión entre la serpiente y las rocas
-bool CheckCollisionWithRock(const SnakeBody& snake, const Rock& rock) {
-    SDL_Point head = snake.segments[0];
-
-    for (const auto& pos : rock.positions) {
-        // Verificamos si la cabeza está dentro de las dimensiones de la roca (32x32 px)
-        if (head.x < pos.x + TILE_SIZE && head.x + TILE_SIZE > pos.x &&
-            head.y < pos.y + TILE_SIZE && head.y + TILE_SIZE > pos.y) {
-            return true;
-            }
-    }
-    return false;
-}
-
-// Sistema de actualización del movimiento de la serpiente
-void UpdateSnakeMovement(entt::registry& registry, float deltaTime) {
-    auto view = registry.view<SnakeBody>();
-
-    for (auto entity : view) {
-        auto& snake = view.get<SnakeBody>(entity);
-
-        // Actualizar el temporizador de movimiento
-        snake.moveTimer += deltaTime;
-
-        // Si ha pasado suficiente tiempo, mover la serpiente
-        if (snake.moveTimer >= MOVE_DELAY) {
-            SDL_Point prevPosition = snake.segments[0];  // Posición anterior de la cabeza
-            Direction prevDirection = snake.direction;  // Dirección anterior de la cabeza
-
-            // Mover la cabeza según la dirección
-            switch (snake.direction) {
-                case UP:
-                    snake.segments[0].y -= snake.speed;
-                    break;
-                case DOWN:
-                    snake.segments[0].y += snake.speed;
-                    break;
-                case LEFT:
-                    snake.segments[0].x -= snake.speed;
-                    break;
-                case RIGHT:
-                    snake.segments[0].x += snake.speed;
-                    break;
-            }
-
-            // Asegurar que la serpiente no salga de los bordes de la pantalla
-            if (snake.segments[0].x < 0) snake.segments[0].x = SCREEN_WIDTH - TILE_SIZE;
-            if (snake.segments[0].x >= SCREEN_WIDTH) snake.segments[0].x = 0;
-            if (snake.segments[0].y < 0) snake.segments[0].y = SCREEN_HEIGHT - TILE_SIZE;
-            if (snake.segments[0].y >= SCREEN_HEIGHT) snake.segments[0].y = 0;
-
-            // Mover el resto del cuerpo de la serpiente
-            for (size_t i = snake.segments.size() - 1; i > 0; --i) {
-                snake.segments[i] = snake.segments[i - 1];
-                snake.directions[i] = snake.directions[i - 1];
-            }
 
-            // El primer segmento del cuerpo sigue a la cabeza (la antigua posición de la cabeza)
-            snake.segments[1] = prevPosition;
-            snake.directions[1] = prevDirection;
-
-            // Crecer si es necesario
-            if (snake.grow) {
-                SDL_Point newSegment = snake.segments.back();  // Posición del último segmento
-                snake.segments.push_back(newSegment);
-                snake.directions.push_back(snake.directions.back());  // Mantener la misma dirección
-                snake.grow = false;
-            }
+// Panel del perfilador: una barra por sección con su tiempo medio por frame, a escala del
+// presupuesto de un frame. Los totales se recogen una vez por segundo.
+struct ProfilerOverlay {
+    bool visible = false;
+    std::vector<const char*> names;   // Secciones en el orden en que aparecieron (fija los colores)
+    std::vector<double> msPerFrame;   // Tiempo medio por frame de cada sección de names
+    std::vector<ProfileTotal> totals;
+    Uint64 windowStart = 0;           // Inicio de la ventana actual, en Profiler::Now()
+    Uint64 frames = 0;                // Frames de la ventana actual
+};
 
-            snake.moveTimer = 0.0f;
+// Cerrar la ventana del panel cada segundo y calcular los tiempos medios por frame
+void UpdateProfilerOverlay(ProfilerOverlay& overlay) {
+    ++overlay.frames;
+    Uint64 now = Profiler::Now();
+    if (now - overlay.windowStart < 1000000000ull) return;
+
+    Profiler::CollectTotals(overlay.windowStart, overlay.totals);
+    std::fill(overlay.msPerFrame.begin(), overlay.msPerFrame.end(), 0.0);
+    for (const auto& total : overlay.totals) {
+        auto name = std::find(overlay.names.begin(), overlay.names.end(), total.name);
+        if (name == overlay.names.end()) {
+            overlay.names.push_back(total.name);
+            overlay.msPerFrame.push_back(0.0);
+            name = overlay.names.end() - 1;
         }
+        overlay.msPerFrame[name - overlay.names.begin()] = total.nanoseconds / 1e6 / overlay.frames;
     }
-}
 
-// Sistema de renderizado para la serpiente
-void RenderSnakeSystem(entt::registry& registry, SDL_Renderer* renderer) {
-    auto view = registry.view<SnakeSegment, SnakeBody>();
-
-    for (auto entity : view) {
-        auto& segment = view.get<SnakeSegment>(entity);
-        auto& snake = view.get<SnakeBody>(entity);
-
-        // Renderizar la cabeza y los segmentos del cuerpo
-        for (size_t i = 0; i < snake.segments.size(); ++i) {
-            SDL_Rect dstRect = { snake.segments[i].x, snake.segments[i].y, TILE_SIZE, TILE_SIZE };
-            SDL_Point center = { TILE_SIZE / 2, TILE_SIZE / 2 };
-            double angle = 0.0;
-
-            if (i == 0) {
-                // Renderizar la cabeza con rotación según la dirección
-                switch (snake.direction) {
-                    case UP:
-                        angle = 180.0;
-                        break;
-                    case DOWN:
-                        angle = 0.0;
-                        break;
-                    case LEFT:
-                        angle = 90.0;
-                        break;
-                    case RIGHT:
-                        angle = 270.0;
-                        break;
-                }
-                SDL_Rect headRect = { 0, 0, 8, 8 };  // Sprite de la cabeza en la posición 1
-                SDL_RenderCopyEx(renderer, segment.texture, &headRect, &dstRect, angle, &center, SDL_FLIP_NONE);
-            } else {
-                // Renderizar los segmentos del cuerpo con rotación
-                SDL_Rect bodyRect = { 8, 0, 8, 8 };  // Usar el sprite del cuerpo (posición 2)
-
-                // Aplicar la rotación solo si el cuerpo se mueve en dirección horizontal
-                switch (snake.directions[i]) {
-                    case UP:
-                    case DOWN:
-                        angle = 0.0;  // No rotar para el movimiento vertical
-                        break;
-                    case LEFT:
-                    case RIGHT:
-                        angle = 90.0;  // Rotar 90 grados para el movimiento horizontal
-                        break;
-                }
-                SDL_RenderCopyEx(renderer, segment.texture, &bodyRect, &dstRect, angle, &center, SDL_FLIP_NONE);
-            }
+    // Sin texto en pantalla, la leyenda de las barras se escribe en la consola
+    if (overlay.visible) {
+        std::cout << "Perfil (ms por frame):";
+        for (size_t i = 0; i < overlay.names.size(); ++i) {
+            std::cout << " " << overlay.names[i] << " " << overlay.msPerFrame[i] << ";";
         }
+        std::cout << std::endl;
     }
-}
-
-
-// Sistema de renderizado para la manzana
-void RenderAppleSystem(entt::registry& registry, SDL_Renderer* renderer) {
-    auto view = registry.view<Apple>();
-
-    for (auto entity : view) {
-        auto& apple = view.get<Apple>(entity);
 
-        SDL_Rect dstRect = { apple.position.x, apple.position.y, TILE_SIZE, TILE_SIZE };
-        SDL_RenderCopy(renderer, apple.texture, NULL, &dstRect);
-    }
+    overlay.windowStart = now;
+    overlay.frames = 0;
 }
 
-void PlayBackgroundMusic(const char* filePath) {
-    SDL_AudioSpec wavSpec;
-    Uint32 wavLength;
-    Uint8* wavBuffer;
-
-    if (SDL_LoadWAV(filePath, &wavSpec, &wavBuffer, &wavLength) == NULL) {
-        std::cerr << "Error al cargar archivo WAV de música de fondo: " << SDL_GetError() << std::endl;
-        return;
-    }
-
-    SDL_AudioDeviceID deviceId = SDL_OpenAudioDevice(NULL, 0, &wavSpec, NULL, 0);
-    if (deviceId == 0) {
-        std::cerr << "Error al abrir el dispositivo de audio: " << SDL_GetError() << std::endl;
-        SDL_FreeWAV(wavBuffer);
-        return;
+void RenderProfilerOverlay(const ProfilerOverlay& overlay, SDL_Renderer* renderer, double frameBudgetMs) {
+    if (!overlay.visible || overlay.names.empty()) return;
+    PROFILE_SCOPE("RenderProfilerOverlay");
+
+    static const SDL_Color colors[] = {
+        { 230, 80, 80, 255 }, { 80, 200, 80, 255 }, { 80, 140, 240, 255 }, { 240, 200, 60, 255 },
+        { 200, 90, 220, 255 }, { 60, 210, 210, 255 }, { 240, 140, 60, 255 }, { 200, 200, 200, 255 }
+    };
+    const int rowHeight = 10;
+    const int maxWidth = SCREEN_WIDTH - 16;
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+    SDL_Rect panel = { 4, 4, SCREEN_WIDTH - 8, static_cast<int>(overlay.names.size()) * rowHeight + 8 };
+    SDL_RenderFillRect(renderer, &panel);
+
+    for (size_t i = 0; i < overlay.names.size(); ++i) {
+        const SDL_Color& color = colors[i % (sizeof(colors) / sizeof(colors[0]))];
+        int width = static_cast<int>(overlay.msPerFrame[i] / frameBudgetMs * maxWidth);
+        SDL_Rect bar = { 8, 8 + static_cast<int>(i) * rowHeight, std::max(1, std::min(width, maxWidth)), rowHeight - 2 };
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderFillRect(renderer, &bar);
     }
-
-    SDL_QueueAudio(deviceId, wavBuffer, wavLength);
-    SDL_PauseAudioDevice(deviceId, 0); // Reproducir audio
-
-    // No bloqueamos con SDL_Delay; dejamos que el audio se reproduzca en segundo plano
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 }
 
-
-// Función para reproducir un efecto de sonido
-void PlaySoundEffect(const char* filePath) {
-    SDL_AudioSpec wavSpec;
-    Uint32 wavLength;
-    Uint8* wavBuffer;
-
-    if (SDL_LoadWAV(filePath, &wavSpec, &wavBuffer, &wavLength) == NULL) {
-        std::cerr << "Error al cargar archivo WAV de efecto de sonido: " << SDL_GetError() << std::endl;
-        return;
-    }
-
-    SDL_AudioDeviceID deviceId = SDL_OpenAudioDevice(NULL, 0, &wavSpec, NULL, 0);
-    if (deviceId == 0) {
-        std::cerr << "Error al abrir el dispositivo de audio: " << SDL_GetError() << std::endl;
-        SDL_FreeWAV(wavBuffer);
-        return;
-    }
-
-    SDL_QueueAudio(deviceId, wavBuffer, wavLength);
-    SDL_PauseAudioDevice(deviceId, 0); // Reproducir audio
-
-    // No bloqueamos con SDL_Delay; el sonido se reproduce en segundo plano
-    SDL_FreeWAV(wavBuffer);
+// Escribir en la consola los percentiles de una distribución de duraciones
+void PrintTimingSummary(const char* label, const TimingSummary& summary) {
+    std::cout << label << ": " << summary.count << " muestras, p50 " << summary.p50 << " ms, p95 " << summary.p95
+              << " ms, p99 " << summary.p99 << " ms, máx " << summary.max << " ms" << std::endl;
 }
 
-
-// Sistema para verificar la colisión entre la serpiente y la manzana
-void CheckCollisionWithApple(entt::registry& registry, int& appleCounter) {
-    auto snakeView = registry.view<SnakeBody>();
-    auto appleView = registry.view<Apple>();
-
-    for (auto snakeEntity : snakeView) {
-        auto& snake = snakeView.get<SnakeBody>(snakeEntity);
-
-        for (auto appleEntity : appleView) {
-            auto& apple = appleView.get<Apple>(appleEntity);
-
-            int snakeX = (snake.segments[0].x / TILE_SIZE) * TILE_SIZE;
-            int snakeY = (snake.segments[0].y / TILE_SIZE) * TILE_SIZE;
-            int appleX = (apple.position.x / TILE_SIZE) * TILE_SIZE;
-            int appleY = (apple.position.y / TILE_SIZE) * TILE_SIZE;
-
-            if (snakeX == appleX && snakeY == appleY) {
-                std::cout << "¡Manzana comida! Contador: " << ++appleCounter << std::endl;
-                snake.grow = true;
-
-                // Reproducir efecto de sonido al comer la manzana
-                PlaySoundEffect("comiendoManzana.wav");
-
-                // Generar nueva manzana en una posición aleatoria
-                apple.position.x = (rand() % (SCREEN_WIDTH / TILE_SIZE)) * TILE_SIZE;
-                apple.position.y = (rand() % (SCREEN_HEIGHT / TILE_SIZE)) * TILE_SIZE;
-            }
+int main(int argc, char* argv[]) {
+    // Ritmo de frames: vsync por defecto, --fps N para una frecuencia fija o --uncapped sin límite
+    // --record cambia el archivo de la grabación; --replay repite una partida grabada
+    FramePacer pacer;
+    const char* recordPath = "last.replay";
+    const char* replayPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--vsync") == 0) {
+            pacer.configure(PACING_VSYNC);
+        } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            pacer.configure(PACING_TARGET_FPS, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--uncapped") == 0) {
+            pacer.configure(PACING_UNCAPPED);
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--vsync | --fps N | --uncapped] [--record ARCHIVO | --replay ARCHIVO]" << std::endl;
+            return -1;
         }
     }
-}
 
-// Sistema para verificar colisión con el cuerpo de la serpiente
-bool CheckSelfCollision(const SnakeBody& snake) {
-    SDL_Point head = snake.segments[0];
-
-    // Verificar si la cabeza colisiona con cualquier segmento del cuerpo, excepto el primero que sigue a la cabeza
-    for (size_t i = 2; i < snake.segments.size(); ++i) {
-        if (head.x == snake.segments[i].x && head.y == snake.segments[i].y) {
-            return true;
-        }
+    // Semilla de la partida; con ella se puede reproducir la misma secuencia de manzanas y rocas.
+    // Al reproducir una repetición se usa la suya y el teclado no mueve la serpiente.
+    Uint64 seed = static_cast<Uint64>(time(nullptr));
+    Replay replay;
+    const bool replaying = replayPath != nullptr;
+    if (replaying) {
+        if (!replay.load(replayPath)) return -1;
+        seed = replay.seed();
+        std::cout << "Reproduciendo " << replayPath << ": " << replay.events().size() << " cambios de dirección, "
+                  << replay.ticks() << " ticks" << (replay.complete() ? "" : " (incompleta)") << std::endl;
     }
-    return false;
-}
-
-// Sistema para renderizar el fondo
-void RenderBackgroundSystem(entt::registry& registry, SDL_Renderer* renderer) {
-    auto view = registry.view<BackgroundTexture>();
+    std::cout << "Semilla: " << seed << std::endl;
 
-    for (auto entity : view) {
-        auto& bg = view.get<BackgroundTexture>(entity);
-        SDL_Rect dstRect = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
-        SDL_RenderCopy(renderer, bg.texture, NULL, &dstRect);
+    // Grabar la partida (semilla y cambios de dirección) para poder repetirla
+    ReplayRecorder recorder;
+    if (!replaying) {
+        recorder.open(recordPath, seed);
     }
-}
-
-int main() {
-    srand(static_cast<unsigned int>(time(nullptr)));
 
     // Inicializar SDL
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
@@ -368,82 +163,101 @@ int main() {
         return -1;
     }
 
-    // Reproducir música de fondo al iniciar el juego
-    PlayBackgroundMusic("fondo.wav");
+    // Mapear el paquete de recursos si existe (mygame_pack assets.pak); si no, se leen los archivos sueltos
+    if (AssetPack::Mount("assets.pak")) {
+        std::cout << "Usando el paquete de recursos assets.pak" << std::endl;
+    }
+
+    // Abrir un único dispositivo de audio para toda la partida y cargar los sonidos una sola vez
+    SoundBank sounds;
+    MusicStream music;
+    AudioMixer mixer;
+    if (mixer.open()) {
+        sounds.load(SOUND_FILES, SOUND_COUNT, mixer.spec());
+
+        // Reproducir música de fondo al iniciar el juego
+        PlayBackgroundMusic(mixer, music, Assets::BACKGROUND_MUSIC.data());
+    }
 
     SDL_Window* window = SDL_CreateWindow("Snake Game", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, SCREEN_WIDTH, SCREEN_HEIGHT, 0);
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE | pacer.rendererFlags());
     if (!renderer) {
         std::cerr << "Error creating renderer: " << SDL_GetError() << std::endl;
+        mixer.close();
+        music.close();
         SDL_DestroyWindow(window);
         SDL_Quit();
         return -1;
     }
+    pacer.attach(window, renderer);
 
     entt::registry registry;
 
-    // Cargar el fondo
-    auto bgTexture = TextureManager::LoadTexture("background.bmp", renderer);
-    if (!bgTexture) {
-        std::cerr << "Error loading background texture: " << SDL_GetError() << std::endl;
-        SDL_DestroyRenderer(renderer);
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return -1;
-    }
+    // Crear el estado de la partida (tablero, serpiente, manzana y rocas)
+    auto snakeEntity = CreateGame(registry, Rng(seed));
 
+    // Medir el coste de cargar las texturas al arrancar, con y sin la caché en formato nativo
+    const Uint64 startupStart = SDL_GetPerformanceCounter();
+    TextureCache::Open("texcache", renderer);
+    TextureManager::SetLoadLogging(true);
+    TextureManager::SetMemoryBudget(TEXTURE_MEMORY_BUDGET);
+
+    // Cargar el fondo en segundo plano; hasta que llegue se dibuja un color liso
     auto bgEntity = registry.create();
-    registry.emplace<BackgroundTexture>(bgEntity, bgTexture->sdlTexture, bgTexture->width, bgTexture->height);
+    registry.emplace<BackgroundTexture>(bgEntity, TextureManager::LoadTextureAsync(Assets::BACKGROUND));
 
-    // Cargar las texturas de la serpiente
-    auto snakeTexture = TextureManager::LoadTexture("snake_sprites.bmp", renderer);
-    if (!snakeTexture) {
-        std::cerr << "Error loading snake sprite texture: " << SDL_GetError() << std::endl;
-        SDL_DestroyRenderer(renderer);
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return -1;
+    // Textura de destino para la capa estática (fondo y rocas)
+    auto& staticLayer = registry.emplace<StaticLayer>(bgEntity);
+    staticLayer.texture = TextureManager::CreateTargetTexture(renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
+    if (!staticLayer.texture) {
+        std::cerr << "Warning: render targets unavailable, drawing the background every frame. SDL_Error: " << SDL_GetError() << std::endl;
     }
 
-    // Crear entidad para la serpiente
-    auto snakeEntity = registry.create();
-    registry.emplace<SnakeBody>(snakeEntity, std::vector<SDL_Point>{{SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2}}, std::vector<Direction>{RIGHT}, RIGHT);
-    registry.emplace<SnakeSegment>(snakeEntity, snakeTexture->sdlTexture, SDL_Rect{0, 0, 8, 8});
-
-    // Cargar la textura de la manzana
-    auto appleTexture = TextureManager::LoadTexture("apple.bmp", renderer);
-    if (!appleTexture) {
-        std::cerr << "Error loading apple texture: " << SDL_GetError() << std::endl;
+    // Empaquetar los sprites del juego en un atlas para dibujarlos todos desde una sola textura
+    if (!TextureManager::BuildAtlas({ Assets::SNAKE_SPRITES, Assets::SNAKE_HEAD_BLINK, Assets::APPLE, Assets::ROCK }, renderer)) {
+        std::cerr << "Error building sprite atlas: " << SDL_GetError() << std::endl;
+        TextureManager::StopLoader();
+        TextureManager::DestroyTargetTexture(staticLayer.texture);
+        mixer.close();
+        music.close();
         SDL_DestroyRenderer(renderer);
         SDL_DestroyWindow(window);
         SDL_Quit();
         return -1;
     }
 
-    auto appleEntity = registry.create();
-    registry.emplace<Apple>(appleEntity, SDL_Point{160, 160}, appleTexture->sdlTexture);
+    const AtlasSprite* snakeSprite = TextureManager::GetSprite(Assets::SNAKE_SPRITES);
+    registry.emplace<SnakeSegment>(snakeEntity, snakeSprite->atlas, snakeSprite->srcRect);
+    registry.emplace<SnakeMesh>(snakeEntity);
 
-    // Cargar la textura de las rocas
-    auto rockTexture = TextureManager::LoadTexture("roca.bmp", renderer);
-    if (!rockTexture) {
-        std::cerr << "Error loading rock texture: " << SDL_GetError() << std::endl;
-        SDL_DestroyRenderer(renderer);
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return -1;
-    }
+    const AtlasSprite* appleSprite = TextureManager::GetSprite(Assets::APPLE);
+    registry.emplace<Sprite>(registry.view<Apple>().front(), appleSprite->atlas, appleSprite->srcRect);
 
-    // Crear la entidad para las rocas
-    GenerateRock(registry, rockTexture->sdlTexture);  // Inicializar las primeras rocas
+    const AtlasSprite* rockSprite = TextureManager::GetSprite(Assets::ROCK);
+    registry.emplace<Sprite>(registry.view<Rock>().front(), rockSprite->atlas, rockSprite->srcRect);
 
     int appleCounter = 0;
     bool running = true;
     SDL_Event event;
-    Uint32 lastTime = SDL_GetTicks();
+    Uint64 simTick = 0;      // Número de ticks de simulación ejecutados
+    bool startupReported = false;
+
+    // Tiempos del bucle con el contador de alta resolución (SDL_GetTicks solo da milisegundos)
+    const Uint64 tickDuration = TICK_MS * SDL_GetPerformanceFrequency() / 1000;
+    Uint64 accumulator = 0;  // Tiempo real pendiente de simular, en ticks del contador
+    Uint64 lastTime = SDL_GetPerformanceCounter();
+    TimingHistogram frameTimes;  // Duración de cada frame completo
+    TimingHistogram tickTimes;   // Coste de cada SimulationTick
+    ProfilerOverlay profilerOverlay;
+    profilerOverlay.windowStart = Profiler::Now();
+    Profiler::SetThreadName("main");
 
     while (running) {
-        Uint32 currentTime = SDL_GetTicks();
-        float deltaTime = (currentTime - lastTime) / 1000.0f;
+        PROFILE_SCOPE("Frame");
+        pacer.beginFrame();
+        Uint64 currentTime = SDL_GetPerformanceCounter();
+        frameTimes.record(currentTime - lastTime);
+        accumulator += currentTime - lastTime;
         lastTime = currentTime;
 
         while (SDL_PollEvent(&event)) {
@@ -451,8 +265,14 @@ int main() {
                 running = false;
             }
 
-            if (event.type == SDL_KEYDOWN) {
+            // El contenido de las texturas de destino se pierde si se reinicia el dispositivo
+            if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+                registry.get<StaticLayer>(bgEntity).dirty = true;
+            }
+
+            if (event.type == SDL_KEYDOWN && !replaying) {
                 auto& snake = registry.get<SnakeBody>(snakeEntity);
+                Direction previous = snake.direction;
                 switch (event.key.keysym.sym) {
                     case SDLK_UP:
                         if (snake.direction != DOWN) snake.direction = UP;
@@ -467,44 +287,134 @@ int main() {
                         if (snake.direction != LEFT) snake.direction = RIGHT;
                         break;
                 }
+
+                // Se graba la dirección aceptada, con el número de ticks ya ejecutados
+                if (snake.direction != previous) {
+                    recorder.record(simTick, snake.direction);
+                }
             }
+
+            if (event.type == SDL_KEYDOWN) {
+                switch (event.key.keysym.sym) {
+                    case SDLK_F2:
+                        // Informe de tiempos a demanda: últimos frames y ticks
+                        PrintTimingSummary("Frames recientes", frameTimes.window());
+                        PrintTimingSummary("Ticks recientes", tickTimes.window());
+                        break;
+                    case SDLK_F3:
+                        // Volcar lo que guardan los anillos del perfilador (chrome://tracing o ui.perfetto.dev)
+                        if (Profiler::WriteChromeTrace("trace.json")) {
+                            std::cout << "Traza escrita en trace.json" << std::endl;
+                        } else if (Profiler::ENABLED) {
+                            std::cerr << "Error: Could not write trace.json" << std::endl;
+                        } else {
+                            std::cout << "Perfilador desactivado (MYGAME_PROFILER)" << std::endl;
+                        }
+                        break;
+                    case SDLK_F4:
+                        profilerOverlay.visible = !profilerOverlay.visible;
+                        break;
+                }
+            }
+        }
+
+        // Simular en ticks fijos, independientes de la velocidad de renderizado. Si un frame
+        // tarda demasiado se descarta el exceso en lugar de encadenar ticks sin fin.
+        if (accumulator > MAX_TICKS_PER_FRAME * tickDuration) {
+            accumulator = MAX_TICKS_PER_FRAME * tickDuration;
         }
 
-        // Actualizar el movimiento de la serpiente
-        UpdateSnakeMovement(registry, deltaTime);
+        while (running && accumulator >= tickDuration) {
+            accumulator -= tickDuration;
+
+            // La repetición aplica los cambios en el mismo punto en que se grabaron
+            if (replaying) {
+                if (simTick >= replay.ticks()) {
+                    std::cout << "Repetición terminada en el tick " << simTick << std::endl;
+                    running = false;
+                    break;
+                }
+                replay.apply(simTick, registry.get<SnakeBody>(snakeEntity));
+            }
+            ++simTick;
 
-        // Verificar colisión con la manzana
-        CheckCollisionWithApple(registry, appleCounter);
+            Uint64 tickStart = SDL_GetPerformanceCounter();
+            int events = SimulationTick(registry, appleCounter);
+            tickTimes.record(SDL_GetPerformanceCounter() - tickStart);
 
-        // Actualizar y mover las rocas cada 15 segundos
-        UpdateRockMovement(registry, deltaTime, rockTexture->sdlTexture);
+            if (events & TICK_APPLE_EATEN) {
+                std::cout << "¡Manzana comida! Contador: " << appleCounter << std::endl;
 
-        // Verificar colisión con el cuerpo
-        auto& snake = registry.get<SnakeBody>(snakeEntity);
-        if (CheckSelfCollision(snake)) {
-            std::cout << "Colisión con el cuerpo. ¡Juego terminado!" << std::endl;
-            running = false;
+                // Reproducir efecto de sonido al comer la manzana
+                PlaySoundEffect(mixer, sounds, SOUND_EAT_APPLE);
+            }
+
+            if (events & TICK_HIT_SELF) {
+                std::cout << "Colisión con el cuerpo. ¡Juego terminado!" << std::endl;
+                running = false;
+            }
+
+            if (events & TICK_HIT_ROCK) {
+                std::cout << "Colisión con la roca. ¡Juego terminado!" << std::endl;
+                running = false;
+            }
         }
 
-        // Verificar colisión con las rocas
-        auto& rock = registry.get<Rock>(registry.view<Rock>().front());
-        if (CheckCollisionWithRock(snake, rock)) {
-            std::cout << "Colisión con la roca. ¡Juego terminado!" << std::endl;
-            running = false;
+        // Fracción del siguiente tick ya transcurrida, para interpolar el dibujo
+        float alpha = static_cast<float>(accumulator) / tickDuration;
+
+        // Subir las texturas que el hilo de carga ya haya decodificado
+        TextureManager::BeginFrame();
+        TextureManager::ProcessUploads(renderer, TEXTURE_UPLOAD_BUDGET_MS);
+
+        // El arranque termina cuando ha llegado el fondo (o ha fallado)
+        const TextureFuture& background = registry.get<BackgroundTexture>(bgEntity).texture;
+        if (!startupReported && (background.ready() || background.failed())) {
+            double startupMs = (SDL_GetPerformanceCounter() - startupStart) * 1000.0 / SDL_GetPerformanceFrequency();
+            std::cout << "Texturas del arranque cargadas en " << startupMs << " ms" << std::endl;
+            TextureManager::SetLoadLogging(false);
+            startupReported = true;
         }
 
         // Renderizar todo
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
 
-        RenderBackgroundSystem(registry, renderer);
-        RenderSnakeSystem(registry, renderer);
+        RenderStaticLayerSystem(registry, renderer);
+        RenderSnakeSystem(registry, renderer, alpha);
         RenderAppleSystem(registry, renderer);
-        RenderRockSystem(registry, renderer);
+
+        UpdateProfilerOverlay(profilerOverlay);
+        RenderProfilerOverlay(profilerOverlay, renderer, 1000.0 / pacer.fps());
 
         SDL_RenderPresent(renderer);
+
+        // Esperar al siguiente frame en lugar de redibujar la misma escena sin descanso
+        pacer.endFrame();
     }
 
+    TextureManager::DestroyTargetTexture(staticLayer.texture);
+    recorder.close(simTick);
+    mixer.close();
+    music.close();
+    const TextureCacheStats& textureStats = TextureManager::GetStats();
+    std::cout << "Texturas: " << textureStats.hits << " aciertos, " << textureStats.misses << " fallos, "
+              << textureStats.evictions << " expulsiones, " << textureStats.residentBytes << " bytes cargados ("
+              << textureStats.pinnedBytes << " fijos)" << std::endl;
+
+    const FramePacerStats& pacing = pacer.stats();
+    const double ticksPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+    std::cout << "Frames: " << pacing.frames << " a " << pacer.fps() << " FPS objetivo, "
+              << pacing.framesOverBudget << " fuera de presupuesto; trabajo " << pacing.workTicks / ticksPerMs
+              << " ms, dormido " << pacing.sleepTicks / ticksPerMs << " ms, espera activa "
+              << pacing.spinTicks / ticksPerMs << " ms" << std::endl;
+    PrintTimingSummary("Frames", frameTimes.session());
+    PrintTimingSummary("Ticks", tickTimes.session());
+
+    TextureManager::StopLoader();
+    TextureManager::UnloadTexture(registry.get<BackgroundTexture>(bgEntity).texture.get());
+    TextureManager::UnloadAtlas();
+    AssetPack::Unmount();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
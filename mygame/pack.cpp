@@ -0,0 +1,103 @@
+// Empaquetador de recursos: junta los .bmp y .wav de un directorio en un paquete para AssetPack.
+//
+// Uso: mygame_pack SALIDA.pak [DIRECTORIO]   (por defecto el directorio actual)
+#include "AssetPack.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct PackedFile {
+    std::string name;
+    fs::path path;
+    Uint32 hash;
+    Uint32 size;
+};
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Uso: " << argv[0] << " SALIDA.pak [DIRECTORIO]" << std::endl;
+        return 1;
+    }
+    fs::path output = argv[1];
+    fs::path directory = argc == 3 ? argv[2] : ".";
+
+    // Reunir los recursos del directorio; el nombre dentro del paquete es el del archivo
+    std::vector<PackedFile> files;
+    std::error_code error;
+    for (const auto& item : fs::directory_iterator(directory, error)) {
+        if (!item.is_regular_file()) continue;
+        std::string extension = item.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension != ".bmp" && extension != ".wav") continue;
+
+        std::string name = item.path().filename().string();
+        files.push_back({ name, item.path(), entt::hashed_string::value(name.c_str()), static_cast<Uint32>(item.file_size()) });
+    }
+    if (error) {
+        std::cerr << "Error: Could not read directory " << directory << ": " << error.message() << std::endl;
+        return 1;
+    }
+
+    // Índice ordenado por hash; dos nombres con el mismo hash no se podrían distinguir
+    std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) { return a.hash < b.hash; });
+    for (size_t i = 1; i < files.size(); ++i) {
+        if (files[i].hash == files[i - 1].hash) {
+            std::cerr << "Error: Hash collision between " << files[i - 1].name << " and " << files[i].name << std::endl;
+            return 1;
+        }
+    }
+
+    // Calcular desplazamientos alineados; el hash del contenido se rellena al copiar los datos
+    AssetPackHeader header = {};
+    std::copy(ASSET_PACK_MAGIC, ASSET_PACK_MAGIC + 4, header.magic);
+    header.version = ASSET_PACK_VERSION;
+    header.count = static_cast<Uint32>(files.size());
+
+    std::vector<AssetPackEntry> entries;
+    Uint64 offset = sizeof(AssetPackHeader) + files.size() * sizeof(AssetPackEntry);
+    for (const auto& file : files) {
+        offset = (offset + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+        entries.push_back({ file.hash, static_cast<Uint32>(offset), file.size, 0 });
+        offset += file.size;
+    }
+    if (offset > 0xFFFFFFFFull) {
+        std::cerr << "Error: Asset pack larger than 4 GB" << std::endl;
+        return 1;
+    }
+
+    std::ofstream out(output, std::ios::binary);
+    if (!out) {
+        std::cerr << "Error: Could not create " << output << std::endl;
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(AssetPackEntry)));
+
+    std::vector<char> data;
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::ifstream in(files[i].path, std::ios::binary);
+        data.assign(files[i].size, 0);
+        if (!in.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+            std::cerr << "Error: Could not read " << files[i].path << std::endl;
+            return 1;
+        }
+        // Relleno hasta el desplazamiento alineado
+        std::streamoff padding = static_cast<std::streamoff>(entries[i].offset) - out.tellp();
+        for (; padding > 0; --padding) out.put(0);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        entries[i].contentHash = AssetPackContentHash(data.data(), data.size());
+        std::cout << files[i].name << ": " << files[i].size << " bytes" << std::endl;
+    }
+
+    // Volver a escribir el índice, ya con los hashes del contenido
+    out.seekp(sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(AssetPackEntry)));
+
+    std::cout << files.size() << " recursos escritos en " << output.string() << std::endl;
+    return out ? 0 : 1;
+}